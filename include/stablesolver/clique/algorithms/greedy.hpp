@@ -11,6 +11,13 @@ const Output greedy_gwmin(
         const Instance& instance,
         const Parameters& parameters = {});
 
+/**
+ * Greedy algorithm which iteratively adds the candidate vertex whose
+ * candidate neighbors have the largest total weight.
+ *
+ * The scores are maintained in a heap which is only updated for the
+ * neighbors of the removed candidates.
+ */
 const Output greedy_strong(
         const Instance& instance,
         const Parameters& parameters = {});
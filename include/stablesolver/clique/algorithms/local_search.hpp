@@ -19,6 +19,15 @@ struct LocalSearchParameters: Parameters
 
     /** Number of threads. */
     Counter number_of_threads = 1;
+
+    /**
+     * Number of perturbations generated at each node of the search; -1 to
+     * generate one perturbation per vertex.
+     *
+     * Otherwise, each perturbation is the best of two random vertices, so
+     * that the sample is biased toward the moves of small loss.
+     */
+    Counter number_of_perturbations = -1;
 };
 
 const Output local_search(
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "stablesolver/stable/reduction.hpp"
+#include "stablesolver/stable/clique_cover.hpp"
 
 #include "optimizationtools/utils/output.hpp"
 #include "optimizationtools/utils/utils.hpp"
@@ -93,6 +94,22 @@ struct Output: optimizationtools::Output
 
 using NewSolutionCallback = std::function<void(const Output&, const std::string&)>;
 
+/**
+ * Structure passed as parameters of the algorithms to determine whether and
+ * how to solve the connected components of the instance independently.
+ */
+struct ComponentDecompositionParameters
+{
+    /**
+     * Boolean indicating if the connected components should be solved
+     * independently.
+     */
+    bool decompose = false;
+
+    /** Number of threads used to solve the components concurrently. */
+    Counter number_of_threads = 1;
+};
+
 struct Parameters: optimizationtools::Parameters
 {
     /** Callback function called when a new best solution is found. */
@@ -101,16 +118,28 @@ struct Parameters: optimizationtools::Parameters
     /** Reduction parameters. */
     ReductionParameters reduction_parameters;
 
+    /** Component decomposition parameters. */
+    ComponentDecompositionParameters component_decomposition_parameters;
+
+    /** Clique cover bound parameters. */
+    CliqueCoverParameters clique_cover_parameters;
+
 
     virtual nlohmann::json to_json() const override
     {
         nlohmann::json json = optimizationtools::Parameters::to_json();
-        json.merge_patch(
-            {"Reduction",
-                {"Enable", reduction_parameters.reduce},
-                {"MaximumNumberOfRounds", reduction_parameters.maximum_number_of_rounds},
-                }
-                );
+        json.merge_patch({
+                {"Reduction", {
+                    {"Enable", reduction_parameters.reduce},
+                    {"MaximumNumberOfRounds", reduction_parameters.maximum_number_of_rounds},
+                    {"TimeLimit", reduction_parameters.time_limit},
+                    {"CacheDirectory", reduction_parameters.cache_directory}}},
+                {"ComponentDecomposition", {
+                    {"Enable", component_decomposition_parameters.decompose},
+                    {"NumberOfThreads", component_decomposition_parameters.number_of_threads}}},
+                {"CliqueCover", {
+                    {"Enable", clique_cover_parameters.enable},
+                    {"NumberOfThreads", clique_cover_parameters.number_of_threads}}}});
         return json;
     }
 
@@ -124,6 +153,14 @@ struct Parameters: optimizationtools::Parameters
             << "Reduction" << std::endl
             << std::setw(width) << std::left << "    Enable: " << reduction_parameters.reduce << std::endl
             << std::setw(width) << std::left << "    Max. # of rounds: " << reduction_parameters.maximum_number_of_rounds << std::endl
+            << std::setw(width) << std::left << "    Time limit: " << reduction_parameters.time_limit << std::endl
+            << std::setw(width) << std::left << "    Cache directory: " << reduction_parameters.cache_directory << std::endl
+            << "Component decomposition" << std::endl
+            << std::setw(width) << std::left << "    Enable: " << component_decomposition_parameters.decompose << std::endl
+            << std::setw(width) << std::left << "    # of threads: " << component_decomposition_parameters.number_of_threads << std::endl
+            << "Clique cover bound" << std::endl
+            << std::setw(width) << std::left << "    Enable: " << clique_cover_parameters.enable << std::endl
+            << std::setw(width) << std::left << "    # of threads: " << clique_cover_parameters.number_of_threads << std::endl
             ;
     }
 };
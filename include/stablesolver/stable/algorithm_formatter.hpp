@@ -1,6 +1,10 @@
 #pragma once
 
 #include "stablesolver/stable/algorithm.hpp"
+#include "stablesolver/stable/instance_builder.hpp"
+
+#include <thread>
+#include <mutex>
 
 namespace stablesolver
 {
@@ -68,7 +72,12 @@ inline const AlgorithmOutput solve_reduced_instance(
         AlgorithmFormatter& algorithm_formatter,
         AlgorithmOutput& output)
 {
-    Reduction reduction(instance, parameters.reduction_parameters);
+    // The reduction can't use more than the remaining time.
+    ReductionParameters reduction_parameters = parameters.reduction_parameters;
+    reduction_parameters.time_limit = (std::min)(
+            reduction_parameters.time_limit,
+            parameters.timer.remaining_time());
+    Reduction reduction(instance, reduction_parameters);
     algorithm_formatter.print_reduced_instance(reduction.instance());
     algorithm_formatter.print_header();
 
@@ -101,7 +110,184 @@ inline const AlgorithmOutput solve_reduced_instance(
                     reduction.unreduce_bound(new_output.bound),
                     s);
         };
-    algorithm(reduction.instance(), new_parameters);
+    const Output& reduced_output = algorithm(reduction.instance(), new_parameters);
+
+    // Keep the statistics of the algorithm at its end, e.g. its number of
+    // iterations.
+    Solution solution = output.solution;
+    Weight bound = output.bound;
+    output = static_cast<const AlgorithmOutput&>(reduced_output);
+    output.solution = solution;
+    output.bound = bound;
+
+    algorithm_formatter.end();
+    return output;
+}
+
+/**
+ * Solve the connected components of an instance independently and merge the
+ * solutions.
+ *
+ * The components are solved concurrently, largest first. When a component is
+ * started, it gets a share of the remaining time proportional to its size
+ * among the components not started yet.
+ */
+template <typename Algorithm, typename AlgorithmParameters, typename AlgorithmOutput>
+inline const AlgorithmOutput solve_components(
+        const Algorithm& algorithm,
+        const Instance& instance,
+        const AlgorithmParameters& parameters,
+        AlgorithmFormatter& algorithm_formatter,
+        AlgorithmOutput& output)
+{
+    algorithm_formatter.print_header();
+
+    // Isolated vertices are in an optimal solution; the other components are
+    // solved by the algorithm.
+    Solution solution(instance);
+    std::vector<ComponentId> component_ids;
+    std::vector<Weight> component_bounds(instance.number_of_components(), 0);
+    std::vector<VertexId> original2component(instance.number_of_vertices(), -1);
+    Counter remaining_size = 0;
+    for (ComponentId component_id = 0;
+            component_id < instance.number_of_components();
+            ++component_id) {
+        const Component& component = instance.component(component_id);
+        for (VertexPos vertex_pos = 0;
+                vertex_pos < (VertexPos)component.vertices.size();
+                ++vertex_pos) {
+            VertexId vertex_id = component.vertices[vertex_pos];
+            original2component[vertex_id] = vertex_pos;
+            component_bounds[component_id] += instance.vertex(vertex_id).weight;
+        }
+        if (component.vertices.size() == 1) {
+            solution.add(component.vertices.front());
+        } else {
+            component_ids.push_back(component_id);
+            remaining_size += component.vertices.size() + component.edges.size();
+        }
+    }
+    algorithm_formatter.update_solution(solution, "isolated vertices");
+    std::sort(
+            component_ids.begin(),
+            component_ids.end(),
+            [&instance](
+                ComponentId component_id_1,
+                ComponentId component_id_2) -> bool
+            {
+                const Component& component_1 = instance.component(component_id_1);
+                const Component& component_2 = instance.component(component_id_2);
+                return component_1.vertices.size() + component_1.edges.size()
+                    > component_2.vertices.size() + component_2.edges.size();
+            });
+
+    Counter number_of_threads = (std::max)((Counter)1, (std::min)(
+                parameters.component_decomposition_parameters.number_of_threads,
+                (Counter)component_ids.size()));
+    Weight bound = instance.total_weight();
+    std::vector<std::vector<VertexId>> component_solutions(instance.number_of_components());
+    ComponentPos component_pos_next = 0;
+    std::exception_ptr exception = nullptr;
+    std::mutex mutex;
+    auto solve = [&]()
+    {
+        for (;;) {
+            // Get the next component and its time limit.
+            ComponentId component_id = -1;
+            double time_limit = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (component_pos_next == (ComponentPos)component_ids.size()
+                        || exception != nullptr
+                        || parameters.timer.needs_to_end()) {
+                    return;
+                }
+                component_id = component_ids[component_pos_next];
+                component_pos_next++;
+                const Component& component = instance.component(component_id);
+                Counter size = component.vertices.size() + component.edges.size();
+                double remaining_time = parameters.timer.remaining_time();
+                time_limit = parameters.timer.elapsed_time() + (std::min)(
+                        remaining_time,
+                        remaining_time * number_of_threads * size / remaining_size);
+                remaining_size -= size;
+            }
+            const Component& component = instance.component(component_id);
+
+            try {
+                // Build the instance of the component.
+                InstanceBuilder instance_builder;
+                instance_builder.add_vertices(component.vertices.size());
+                for (VertexPos vertex_pos = 0;
+                        vertex_pos < (VertexPos)component.vertices.size();
+                        ++vertex_pos) {
+                    instance_builder.set_weight(
+                            vertex_pos,
+                            instance.vertex(component.vertices[vertex_pos]).weight);
+                }
+                for (EdgeId edge_id: component.edges) {
+                    instance_builder.add_edge(
+                            original2component[instance.edge(edge_id).vertex_id_1],
+                            original2component[instance.edge(edge_id).vertex_id_2],
+                            0);
+                }
+                Instance component_instance = instance_builder.build();
+
+                // Solve it.
+                AlgorithmParameters component_parameters = parameters;
+                component_parameters.reduction_parameters.reduce = false;
+                component_parameters.component_decomposition_parameters.decompose = false;
+                component_parameters.verbosity_level = 0;
+                component_parameters.timer.set_time_limit(time_limit);
+                component_parameters.new_solution_callback = [
+                    &algorithm_formatter,
+                    &solution,
+                    &bound,
+                    &component_bounds,
+                    &component_solutions,
+                    &mutex,
+                    &component,
+                    component_id](
+                            const Output& component_output,
+                            const std::string&)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        std::string s = "component " + std::to_string(component_id);
+                        const Solution& component_solution = component_output.solution;
+                        if (component_solution.feasible()
+                                && solution.weight(component_id) < component_solution.weight()) {
+                            for (VertexId vertex_id: component_solutions[component_id])
+                                solution.remove(vertex_id);
+                            component_solutions[component_id].clear();
+                            for (VertexId vertex_pos: component_solution.vertices()) {
+                                VertexId vertex_id = component.vertices[vertex_pos];
+                                solution.add(vertex_id);
+                                component_solutions[component_id].push_back(vertex_id);
+                            }
+                            algorithm_formatter.update_solution(solution, s);
+                        }
+                        if (component_bounds[component_id] > component_output.bound) {
+                            bound -= component_bounds[component_id] - component_output.bound;
+                            component_bounds[component_id] = component_output.bound;
+                            algorithm_formatter.update_bound(bound, s);
+                        }
+                    };
+                algorithm(component_instance, component_parameters);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                exception = std::current_exception();
+                return;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 1; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(solve));
+    solve();
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
 
     algorithm_formatter.end();
     return output;
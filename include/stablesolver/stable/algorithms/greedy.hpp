@@ -11,6 +11,18 @@ struct GreedyParameters: Parameters
 {
 };
 
+/**
+ * Greedy algorithm which iteratively adds the vertex maximizing its weight
+ * divided by its residual degree plus one, and removes its neighbors.
+ *
+ * The residual degrees are maintained in a heap which is only updated for
+ * the neighbors of the removed vertices, in O((n + m) log n).
+ *
+ * See:
+ * - "A note on greedy algorithms for the maximum weighted independent set
+ *   problem" (Sakai et al., 2003)
+ *   https://doi.org/10.1016/S0166-218X(02)00205-6
+ */
 const Output greedy_gwmin(
         const Instance& instance,
         const GreedyParameters& parameters = {});
@@ -23,9 +35,112 @@ const Output greedy_gwmin2(
         const Instance& instance,
         const GreedyParameters& parameters = {});
 
+/**
+ * Greedy algorithm which iteratively adds the vertex whose available
+ * neighbors have the smallest total weight, and removes its neighbors.
+ *
+ * The scores are maintained in a heap which is only updated for the
+ * neighbors of the removed vertices, in O((n + m) log n).
+ */
 const Output greedy_strong(
         const Instance& instance,
         const GreedyParameters& parameters = {});
 
+struct GreedyParallelParameters: GreedyParameters
+{
+    /** Number of threads. */
+    Counter number_of_threads = 1;
+
+    /** Seed used to break ties between vertices with the same priority. */
+    Seed seed = 0;
+};
+
+/**
+ * Parallel greedy algorithm with static GWMIN priorities.
+ *
+ * The vertices are ordered by weight divided by degree plus one, ties broken by a hash of the
+ * seed and of the vertex. The algorithm returns the solution of the
+ * sequential greedy considering the vertices in this order, whatever the
+ * number of threads.
+ *
+ * The vertices are processed in rounds: in each round, an undecided vertex
+ * is added if none of its undecided neighbors has a higher priority, and
+ * removed if one of its neighbors has been added. A round only considers a
+ * prefix of the undecided vertices, to bound the total work.
+ *
+ * See:
+ * - "Greedy sequential maximal independent set and matching are parallel on
+ *   average" (Blelloch et al., 2012)
+ *   https://doi.org/10.1145/2312005.2312058
+ */
+const Output greedy_parallel(
+        const Instance& instance,
+        const GreedyParallelParameters& parameters = {});
+
+struct GreedyMultistartParameters: GreedyParameters
+{
+    /** Number of threads. */
+    Counter number_of_threads = 1;
+
+    /** Number of restarts. */
+    Counter number_of_restarts = 256;
+
+    /** Seed. */
+    Seed seed = 0;
+
+    /**
+     * Amplitude of the perturbation of the priorities.
+     *
+     * The priority of each vertex is multiplied by a factor drawn uniformly
+     * in [1 - noise, 1 + noise].
+     */
+    double noise = 0.2;
+};
+
+struct GreedyMultistartOutput: Output
+{
+    GreedyMultistartOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /** Number of restarts. */
+    Counter number_of_restarts = 0;
+
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfRestarts", number_of_restarts}});
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of restarts: " << number_of_restarts << std::endl
+            ;
+    }
+};
+
+/**
+ * Multi-start greedy algorithm.
+ *
+ * Each restart sorts the vertices by perturbed GWMIN, GWMIN2 or GWMAX
+ * priority, in turn, and adds them greedily. The random stream of a restart
+ * only depends on the seed and on the restart id, so the value of the
+ * returned solution doesn't depend on the number of threads, unless the time
+ * limit is reached.
+ *
+ * Each thread allocates its buffers once; a restart only allocates when it
+ * improves the best solution.
+ */
+const GreedyMultistartOutput greedy_multistart(
+        const Instance& instance,
+        const GreedyMultistartParameters& parameters = {});
+
 }
 }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "stablesolver/stable/algorithm.hpp"
+
+namespace stablesolver
+{
+namespace stable
+{
+
+struct IteratedLocalSearchParameters: Parameters
+{
+    /** Maximum number of iterations. */
+    Counter maximum_number_of_iterations = -1;
+
+    /** Maximum number of iterations without improvement. */
+    Counter maximum_number_of_iterations_without_improvement = -1;
+};
+
+struct IteratedLocalSearchOutput: Output
+{
+    IteratedLocalSearchOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /** Number of iterations. */
+    Counter number_of_iterations = 0;
+
+    /** Number of improving moves. */
+    Counter number_of_moves = 0;
+
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfIterations", number_of_iterations},
+                {"NumberOfMoves", number_of_moves}});
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of iterations: " << number_of_iterations << std::endl
+            << std::setw(width) << std::left << "Number of moves: " << number_of_moves << std::endl
+            ;
+    }
+};
+
+/**
+ * Iterated local search with a variable neighborhood descent.
+ *
+ * The descent uses two neighborhoods:
+ * - (ω,1)-swap: add a vertex heavier than its neighbors in the solution, and
+ *   remove them. It includes the addition of free vertices;
+ * - (1,2)-swap: replace a vertex of the solution by two non-adjacent 1-tight
+ *   neighbors, that is, neighbors with no other neighbor in the solution, of
+ *   larger total weight.
+ * (1,2)-swaps are only tried when no (ω,1)-swap is improving.
+ *
+ * The weight of the solution neighbors of each vertex, its tightness and
+ * the set of vertices with an improving (ω,1)-swap are updated
+ * incrementally when a vertex is added or removed. A vertex of the solution
+ * is only checked for (1,2)-swaps when one of its neighbors becomes 1-tight.
+ * Thus, finding and applying a move only depends on the degrees of the
+ * vertices involved, and not on the size of the instance.
+ *
+ * The perturbation forces a random vertex into the solution. A move which
+ * leads to a worse local optimum is undone.
+ *
+ * See:
+ * - "Fast local search for the maximum independent set problem" (Andrade et
+ *   al., 2012)
+ *   https://doi.org/10.1007/s10732-012-9196-4
+ * - "A hybrid iterated local search heuristic for the maximum weight
+ *   independent set problem" (Nogueira et al., 2018)
+ *   https://doi.org/10.1007/s11590-017-1128-7
+ */
+const IteratedLocalSearchOutput iterated_local_search(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const IteratedLocalSearchParameters& parameters = {});
+
+}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "stablesolver/stable/algorithm.hpp"
+
+namespace stablesolver
+{
+namespace stable
+{
+
+struct LagrangianRelaxationParameters: Parameters
+{
+    /**
+     * Boolean indicating if the constraints of a clique cover should be
+     * relaxed together with the edge constraints between the cliques.
+     *
+     * If 'false', only the edge constraints are relaxed.
+     */
+    bool clique_constraints = true;
+
+    /** Maximum number of iterations. */
+    Counter maximum_number_of_iterations = -1;
+
+    /** Initial value of the step size coefficient. */
+    double initial_step_size_coefficient = 2.0;
+
+    /**
+     * Number of iterations without improvement of the bound after which the
+     * step size coefficient is halved.
+     */
+    Counter number_of_iterations_before_step_size_update = 20;
+
+    /** Step size coefficient below which the algorithm stops. */
+    double minimum_step_size_coefficient = 1e-4;
+};
+
+struct LagrangianRelaxationOutput: Output
+{
+    LagrangianRelaxationOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /** Number of iterations. */
+    Counter number_of_iterations = 0;
+
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfIterations", number_of_iterations}});
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of iterations: " << number_of_iterations << std::endl
+            ;
+    }
+};
+
+/**
+ * Lagrangian relaxation of the edge (and clique) constraints, optimized with
+ * a subgradient algorithm.
+ *
+ * For given multipliers, the relaxed problem decomposes into an independent
+ * decision per vertex: take it if its reduced weight is positive. Each
+ * iteration is therefore linear in the size of the instance.
+ *
+ * A Lagrangian heuristic, which greedily repairs the solution of the relaxed
+ * problem, is used to compute solutions.
+ *
+ * See:
+ * - "The Lagrangian Relaxation Method for Solving Integer Programming
+ *   Problems" (Fisher, 1981)
+ *   https://doi.org/10.1287/mnsc.27.1.1
+ */
+const LagrangianRelaxationOutput lagrangian_relaxation(
+        const Instance& instance,
+        const LagrangianRelaxationParameters& parameters = {});
+
+}
+}
@@ -9,27 +9,193 @@ namespace stable
 
 struct LargeNeighborhoodSearchParameters: Parameters
 {
-    /** Number of threads. */
+    /** Number of threads, that is, of walkers. */
     Counter number_of_threads = 3;
 
+    /** Seed. The seeds of the walkers are drawn from it. */
+    Seed seed = 0;
+
+    /**
+     * Number of iterations between two checks of whether a walker lags
+     * behind the best solution found by the walkers. A lagging walker
+     * restarts from this solution. -1 to never restart.
+     */
+    Counter restart_interval = -1;
+
     /** Maximum number of iterations. */
     Counter maximum_number_of_iterations = -1;
 
     /** Maximum number of iterations without improvement. */
     Counter maximum_number_of_iterations_without_improvement = -1;
+
+    /**
+     * Boolean indicating if a Lagrangian relaxation bound should be computed
+     * in parallel of the search.
+     *
+     * The search stops as soon as its best solution reaches the bound.
+     */
+    bool lagrangian_relaxation_bound = false;
+
+    /**
+     * Number of consecutive iterations using the same destroy operator and
+     * the same destroy size.
+     */
+    Counter adaptive_block_length = 10;
+
+    /**
+     * Number of iterations between two updates of the weights of the destroy
+     * operators and of the destroy sizes.
+     */
+    Counter adaptive_segment_length = 100;
+
+    /**
+     * Reaction factor of the weights, between 0 (the weights never change)
+     * and 1 (the weights only depend on the last segment).
+     */
+    double adaptive_reaction_factor = 0.2;
+
+    /**
+     * Boolean indicating if the weights should be updated with the gain per
+     * iteration instead of the gain per millisecond.
+     *
+     * The gain per millisecond depends on the measured running times, so two
+     * runs with the same seed may diverge. With this option, a single walker
+     * and no time limit, a run only depends on the seed.
+     */
+    bool deterministic = false;
+};
+
+/**
+ * Structure for the statistics of a destroy operator or of a destroy size.
+ */
+struct LargeNeighborhoodSearchStatistics
+{
+    /** Name. */
+    std::string name;
+
+    /** Number of iterations using it. */
+    Counter number_of_calls = 0;
+
+    /** Number of iterations using it which improved the best solution of their walker. */
+    Counter number_of_improvements = 0;
+
+    /**
+     * Sum of the gains of the blocks using it, that is, of the increases of
+     * the weight of the current solution during the blocks.
+     */
+    Weight gain = 0;
+
+    /** Time spent in the iterations using it, in seconds. */
+    double time = 0;
+
+
+    /** Gain per millisecond. */
+    double gain_per_millisecond() const
+    {
+        return (time > 0)? gain / (1000 * time): 0;
+    }
+
+    nlohmann::json to_json() const
+    {
+        return nlohmann::json{
+            {"Name", name},
+            {"NumberOfCalls", number_of_calls},
+            {"NumberOfImprovements", number_of_improvements},
+            {"Gain", gain},
+            {"Time", time},
+            {"GainPerMillisecond", gain_per_millisecond()}};
+    }
 };
 
 struct LargeNeighborhoodSearchOutput: Output
 {
     LargeNeighborhoodSearchOutput(
             const Instance& instance):
-        Output(instance) { }
+        Output(instance)
+    {
+        for (std::string name: {"score", "random", "component", "ball"})
+            destroy_operators.push_back({name});
+        for (std::string name: {"x1/4", "x1/2", "x1", "x2", "x4"})
+            destroy_sizes.push_back({name});
+    }
 
 
     /** Number of iterations. */
     Counter iterations = 0;
+
+    /** Statistics of the destroy operators. */
+    std::vector<LargeNeighborhoodSearchStatistics> destroy_operators;
+
+    /**
+     * Statistics of the destroy sizes, given as factors of the square root
+     * of the number of vertices outside of the solution.
+     */
+    std::vector<LargeNeighborhoodSearchStatistics> destroy_sizes;
+
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json["NumberOfIterations"] = iterations;
+        for (const LargeNeighborhoodSearchStatistics& statistics: destroy_operators)
+            json["DestroyOperators"].push_back(statistics.to_json());
+        for (const LargeNeighborhoodSearchStatistics& statistics: destroy_sizes)
+            json["DestroySizes"].push_back(statistics.to_json());
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os << std::setw(width) << std::left << "Number of iterations: " << iterations << std::endl;
+        for (const LargeNeighborhoodSearchStatistics& statistics: destroy_operators) {
+            os << std::setw(width) << std::left << "Operator " + statistics.name + ": "
+                << statistics.number_of_calls << " calls, "
+                << statistics.gain_per_millisecond() << " gain/ms" << std::endl;
+        }
+        for (const LargeNeighborhoodSearchStatistics& statistics: destroy_sizes) {
+            os << std::setw(width) << std::left << "Size " + statistics.name + ": "
+                << statistics.number_of_calls << " calls, "
+                << statistics.gain_per_millisecond() << " gain/ms" << std::endl;
+        }
+    }
 };
 
+/**
+ * Large neighborhood search.
+ *
+ * At each iteration, a destroy operator adds vertices outside of the
+ * solution to the solution, the penalties of the conflicting edges are
+ * increased, and the vertices of the solution with the largest scores are
+ * removed until the solution is feasible again.
+ *
+ * The destroy operators select the vertices added:
+ * - score: the vertices with the smallest scores;
+ * - random: random vertices;
+ * - component: random vertices of the component of a random vertex;
+ * - ball: the vertices closest to a random vertex, by breadth-first search.
+ * The number of vertices added is the square root of the number of vertices
+ * outside of the solution times a factor between 1/4 and 4. The operator and
+ * the factor are drawn for a block of iterations, with probabilities
+ * proportional to adaptive weights. At the end of each segment of
+ * iterations, the weights are updated with the gain per millisecond of the
+ * blocks of the segment, where the gain of a block is the increase of the
+ * weight of the current solution between its start and its best iteration.
+ * Since the weights depend on the measured running times, the search is not
+ * reproducible unless 'deterministic' is set, in which case the gain per
+ * iteration is used instead.
+ *
+ * With several threads, independent walkers run concurrently, each with its
+ * own penalties, weights and random number generator. The best solution is
+ * shared by all walkers, and the restarts depend on the interleaving of the
+ * walkers.
+ *
+ * See:
+ * - "An Adaptive Large Neighborhood Search Heuristic for the Pickup and
+ *   Delivery Problem with Time Windows" (Ropke and Pisinger, 2006)
+ *   https://doi.org/10.1287/trsc.1050.0135
+ */
 const LargeNeighborhoodSearchOutput large_neighborhood_search(
         const Instance& instance,
         const LargeNeighborhoodSearchParameters& parameters = {});
@@ -3,7 +3,8 @@
  *
  * Two neighborhoods are implemented:
  * - Add: add a vertex to the solution and remove its neighbors.
- *   Complexity: O(n)
+ *   The vertices whose addition improves the solution are maintained when
+ *   vertices are added or removed, so one of them is drawn in O(1).
  * - (2-1)-swap: remove an item from the knapsack and add two of its neighbors
  *   which are not neighbors.
  *   Complexity: O(number of edges)
@@ -15,6 +16,17 @@
  *     independent set problem" (Nogueira et al., 2018)
  *     https://doi.org/10.1007/s11590-017-1128-7
  *
+ * Island model:
+ * The search is split into epochs of 'migration_interval' seconds. During an
+ * epoch, each island runs a best-first local search with its own seed. At
+ * the end of an epoch, it publishes its elite solution in its slot, and the
+ * next epoch starts from the best of its own elite solution and of the elite
+ * solutions it receives according to the migration topology. The slots are
+ * read and written with the atomic shared_ptr operations, so an island only
+ * synchronizes with the others for the copy of a pointer, once per epoch.
+ * These operations are not lock-free: libstdc++ implements them with an
+ * internal pool of mutexes.
+ *
  */
 
 #pragma once
@@ -26,18 +38,79 @@ namespace stablesolver
 namespace stable
 {
 
+/**
+ * Topology of the migrations of the island model.
+ */
+enum class MigrationTopology
+{
+    /** Each island receives the elite solution of the previous island. */
+    Ring,
+
+    /** Each island receives the best elite solution of the other islands. */
+    Complete,
+};
+
 struct LocalSearchParameters: Parameters
 {
-    /** Maximum number of nodes. */
+    /**
+     * Maximum number of nodes.
+     *
+     * With the island model, it applies to each epoch of each island.
+     */
     Counter maximum_number_of_nodes = -1;
 
     /** Number of threads. */
     Counter number_of_threads = 1;
+
+    /**
+     * Number of perturbations generated at each node of the search; -1 to
+     * generate one perturbation per vertex.
+     *
+     * Otherwise, each perturbation is the best of two random vertices, so
+     * that the sample is biased toward the moves of small loss.
+     */
+    Counter number_of_perturbations = -1;
+
+    /**
+     * Number of islands.
+     *
+     * If greater than 1, each island runs its own search in its own thread,
+     * and the islands periodically exchange their elite solutions.
+     */
+    Counter number_of_islands = 1;
+
+    /** Time between two migrations, in seconds. */
+    double migration_interval = 1.0;
+
+    /** Migration topology. */
+    MigrationTopology migration_topology = MigrationTopology::Ring;
+
+    /** Seed. */
+    Seed seed = 0;
 };
 
 const Output local_search(
         const Instance& instance,
         const LocalSearchParameters& parameters = {});
 
+/**
+ * Compute the gains of a batch of consecutive vertices for a solution.
+ *
+ * The gain of a vertex outside the solution is the variation of the weight
+ * of the solution when it is added and its neighbors are removed, that is,
+ * its weight minus the weight of its neighbors in the solution. The gain of
+ * a vertex of the solution is minus its weight, since it has no neighbor in
+ * the solution.
+ *
+ * The arrays are indexed by vertex; 'in[vertex_id]' is 1 iff the vertex is
+ * in the solution.
+ */
+void compute_add_gains(
+        VertexId number_of_vertices,
+        const Weight* weights,
+        const Weight* neighbor_weights,
+        const int8_t* in,
+        Weight* gains);
+
 }
 }
@@ -18,6 +18,16 @@ struct LocalSearchRowWeighting1Parameters: Parameters
 
     /** Maximum number of iterations without improvement. */
     Counter maximum_number_of_iterations_without_improvement = -1;
+
+    /** Number of threads, that is, of walkers. */
+    Counter number_of_threads = 1;
+
+    /**
+     * Number of iterations between two checks of whether a walker lags
+     * behind the best solution found by the walkers. A lagging walker
+     * restarts from this solution. -1 to never restart.
+     */
+    Counter restart_interval = -1;
 };
 
 struct LocalSearchRowWeighting1Output: Output
@@ -29,8 +39,63 @@ struct LocalSearchRowWeighting1Output: Output
 
     /** Number of iterations. */
     Counter number_of_iterations = 0;
+
+    /** Number of components proved optimal by the scheduler. */
+    ComponentId number_of_optimal_components = 0;
+
+    /** Number of iterations per second. */
+    double number_of_iterations_per_second() const
+    {
+        return (time > 0)? number_of_iterations / time: 0;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfIterations", number_of_iterations},
+                {"NumberOfIterationsPerSecond", number_of_iterations_per_second()},
+                {"NumberOfOptimalComponents", number_of_optimal_components}});
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of iterations: " << number_of_iterations << std::endl
+            << std::setw(width) << std::left << "Iterations per second: " << number_of_iterations_per_second() << std::endl
+            << std::setw(width) << std::left << "Number of optimal components: " << number_of_optimal_components << std::endl
+            ;
+    }
 };
 
+/**
+ * Row weighting local search.
+ *
+ * Each edge has a penalty, increased when both of its ends are in the
+ * solution. The score of a vertex, that is, the sum of the penalties of its
+ * edges whose other end is in the solution, is updated incrementally when a
+ * vertex is added or removed. The vertices outside of the solution are kept
+ * in an indexed binary heap per component, by score and then by timestamp,
+ * so that a move is selected without scanning the component.
+ *
+ * When a penalty gets too large, all penalties are halved lazily: a global
+ * epoch is incremented, and the penalty of an edge and the score of a vertex
+ * are brought up to date on their next access.
+ *
+ * The components are optimized in turn, each during a slice proportional to
+ * its number of edges. The slice of a component grows when its best solution
+ * has improved during its last slice, and shrinks otherwise. A component
+ * whose best solution reaches its clique cover bound is optimal and is not
+ * optimized anymore.
+ *
+ * With several threads, independent walkers run concurrently, each with its
+ * own penalties and random number generator. They exchange the best solution
+ * through atomic shared_ptr operations, and only synchronize for the copy of
+ * a pointer.
+ */
 const LocalSearchRowWeighting1Output local_search_row_weighting_1(
         const Instance& instance,
         std::mt19937_64& generator,
@@ -47,6 +112,16 @@ struct LocalSearchRowWeighting2Parameters: Parameters
 
     /** Maximum number of iterations without improvement. */
     Counter maximum_number_of_iterations_without_improvement = -1;
+
+    /** Number of threads, that is, of walkers. */
+    Counter number_of_threads = 1;
+
+    /**
+     * Number of iterations between two checks of whether a walker lags
+     * behind the best solution found by the walkers. A lagging walker
+     * restarts from this solution. -1 to never restart.
+     */
+    Counter restart_interval = -1;
 };
 
 struct LocalSearchRowWeighting2Output: Output
@@ -58,8 +133,40 @@ struct LocalSearchRowWeighting2Output: Output
 
     /** Number of iterations. */
     Counter number_of_iterations = 0;
+
+    /** Number of iterations per second. */
+    double number_of_iterations_per_second() const
+    {
+        return (time > 0)? number_of_iterations / time: 0;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfIterations", number_of_iterations},
+                {"NumberOfIterationsPerSecond", number_of_iterations_per_second()}});
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of iterations: " << number_of_iterations << std::endl
+            << std::setw(width) << std::left << "Iterations per second: " << number_of_iterations_per_second() << std::endl
+            ;
+    }
 };
 
+/**
+ * Row weighting local search in which the vertex added and the vertex
+ * removed at each iteration are chosen separately.
+ *
+ * As for 'local_search_row_weighting_1', several walkers may run
+ * concurrently.
+ */
 const LocalSearchRowWeighting2Output local_search_row_weighting_2(
         const Instance& instance,
         std::mt19937_64& generator,
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "stablesolver/stable/algorithm.hpp"
+
+namespace stablesolver
+{
+namespace stable
+{
+
+struct ReduceAndPeelParameters: Parameters
+{
+};
+
+struct ReduceAndPeelOutput: Output
+{
+    ReduceAndPeelOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /**
+     * Number of vertices to which a reduction rule has been applied, that
+     * is, which have been taken or folded.
+     */
+    VertexId number_of_reduced_vertices = 0;
+
+    /** Number of peeled vertices. */
+    VertexId number_of_peeled_vertices = 0;
+
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"NumberOfReducedVertices", number_of_reduced_vertices},
+                {"NumberOfPeeledVertices", number_of_peeled_vertices}});
+        return json;
+    }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of reduced vertices: " << number_of_reduced_vertices << std::endl
+            << std::setw(width) << std::left << "Number of peeled vertices: " << number_of_peeled_vertices << std::endl
+            ;
+    }
+};
+
+/**
+ * Reduce-and-peel heuristic.
+ *
+ * Reduction rules for vertices of degree at most 2 are applied on the fly,
+ * without rebuilding the instance. When no rule applies, the vertex of
+ * highest residual degree is peeled, that is, removed from the graph. The
+ * vertices are kept in buckets by residual degree, so the algorithm runs in
+ * O(n + m) time, up to the adjacency tests of the degree-2 rule.
+ *
+ * Since the rules are exact, the returned bound is the weight of the
+ * solution plus the weights of the peeled vertices.
+ *
+ * The rules are weighted versions of the degree-0, degree-1 and degree-2
+ * rules:
+ * - a vertex whose neighbors weigh at most its own weight is taken;
+ * - a vertex of degree 2 in a triangle and at least as heavy as its
+ *   neighbors is taken;
+ * - a vertex of degree 1 lighter than its neighbor is folded into it.
+ *
+ * See:
+ * - "Computing A Near-Maximum Independent Set in Linear Time by
+ *   Reducing-Peeling" (Chang et al., 2017)
+ *   https://doi.org/10.1145/3035918.3035939
+ */
+const ReduceAndPeelOutput reduce_and_peel(
+        const Instance& instance,
+        const ReduceAndPeelParameters& parameters = {});
+
+}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "stablesolver/stable/instance.hpp"
+
+#include <random>
+
+namespace stablesolver
+{
+namespace stable
+{
+
+/**
+ * Structure passed as parameters of the algorithms to determine whether and
+ * how to compute the clique cover bound.
+ */
+struct CliqueCoverParameters
+{
+    /** Boolean indicating if the clique cover bound should be computed. */
+    bool enable = true;
+
+    /** Number of threads used to compute the clique covers of the components. */
+    Counter number_of_threads = 1;
+};
+
+/**
+ * Class that computes an upper bound from a partition of the vertices into
+ * cliques.
+ *
+ * An independent set contains at most one vertex of each clique, therefore
+ * the sum over the cliques of their maximum vertex weight is an upper bound.
+ *
+ * The initial partition is computed greedily, considering the vertices by
+ * non-increasing weight. It can then be refined by iterated greedy passes
+ * which consider the vertices clique by clique.
+ *
+ * See:
+ * - "Iterated Greedy Graph Coloring and the Difficulty Landscape"
+ *   (Culberson, 1992)
+ */
+class CliqueCover
+{
+
+public:
+
+    /** Constructor. */
+    CliqueCover(
+            const Instance& instance,
+            const CliqueCoverParameters& parameters = {});
+
+    /** Get the bound. */
+    inline Weight bound() const { return bound_; }
+
+    /** Get the bound of a connected component. */
+    Weight component_bound(ComponentId component_id) const;
+
+    /** Get the cliques of the cover. */
+    std::vector<std::vector<VertexId>> cliques() const;
+
+    /** Get the time spent computing the clique cover. */
+    inline double time() const { return time_; }
+
+    /**
+     * Perform an iterated greedy pass on each component.
+     *
+     * Return 'true' if the bound has been improved.
+     */
+    bool improve(
+            std::mt19937_64& generator);
+
+private:
+
+    /*
+     * Private methods
+     */
+
+    /**
+     * Structure that stores a clique cover of a connected component.
+     */
+    struct ComponentCliqueCover
+    {
+        /** Vertices of the component, grouped by clique. */
+        std::vector<VertexId> vertices;
+
+        /** Position of the first vertex of each clique in 'vertices'. */
+        std::vector<VertexPos> clique_starts = {0};
+
+        /** Sum over the cliques of their maximum vertex weight. */
+        Weight bound = 0;
+    };
+
+    /**
+     * Compute a clique cover of a component by adding the vertices in the
+     * given order, each one to the clique where it increases the bound the
+     * least.
+     *
+     * If 'generator' is not 'nullptr', ties are broken randomly.
+     */
+    ComponentCliqueCover partition(
+            const std::vector<VertexId>& vertices,
+            std::mt19937_64* generator);
+
+    /** Call a function on each component, in parallel. */
+    template <typename Function>
+    void for_each_component(
+            const Function& function);
+
+    /*
+     * Private attributes
+     */
+
+    /** Instance. */
+    const Instance* instance_;
+
+    /** Parameters. */
+    CliqueCoverParameters parameters_;
+
+    /** For each component, its clique cover. */
+    std::vector<ComponentCliqueCover> components_;
+
+    /**
+     * For each vertex, the clique containing it during the current call to
+     * 'partition'.
+     */
+    std::vector<VertexPos> vertex_cliques_;
+
+    /** Bound. */
+    Weight bound_;
+
+    /** Time spent computing the clique cover. */
+    double time_ = 0.0;
+
+};
+
+}
+}
@@ -16,6 +16,7 @@ using EdgeId = int64_t;
 using EdgePos = int64_t;
 using Weight = int64_t;
 using ComponentId = int64_t;
+using ComponentPos = int64_t;
 using Penalty = int16_t;
 using Counter = int64_t;
 using Seed = int64_t;
@@ -45,7 +46,7 @@ struct Vertex
     /** Id of the connected component of the vertex. */
     ComponentId component = -1;
 
-    /** Neighbors of the vertex. */
+    /** Neighbors of the vertex, sorted by increasing vertex id. */
     std::vector<VertexEdge> edges;
 };
 
@@ -121,6 +122,28 @@ public:
     /** Get the total weight. */
     inline Weight total_weight() const { return total_weight_; }
 
+    /*
+     * Adjacency queries
+     */
+
+    /** Check if there is an edge between two vertices. */
+    bool has_edge(
+            VertexId vertex_id_1,
+            VertexId vertex_id_2) const;
+
+    /**
+     * Check if all the neighbors of 'vertex_id_1', except 'vertex_id_2', are
+     * neighbors of 'vertex_id_2'.
+     */
+    bool is_neighborhood_included(
+            VertexId vertex_id_1,
+            VertexId vertex_id_2) const;
+
+    /** Get the number of common neighbors of two vertices. */
+    VertexPos number_of_common_neighbors(
+            VertexId vertex_id_1,
+            VertexId vertex_id_2) const;
+
     /*
      * Export
      */
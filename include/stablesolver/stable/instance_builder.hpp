@@ -53,6 +53,9 @@ private:
      * Private methods
      */
 
+    /** Sort the neighbors of each vertex by increasing vertex id. */
+    void sort_adjacency_lists();
+
     /** Compute the maximum degree. */
     void compute_highest_degree();
 
@@ -2,6 +2,10 @@
 
 #include "stablesolver/stable/solution.hpp"
 
+#include <initializer_list>
+#include <chrono>
+#include <limits>
+
 namespace stablesolver
 {
 namespace stable
@@ -18,6 +22,24 @@ struct ReductionParameters
 
     /** Maximum number of rounds. */
     Counter maximum_number_of_rounds = 10;
+
+    /**
+     * Time limit of the reduction, in seconds.
+     *
+     * When it is reached, the reduction stops and the instance reduced so
+     * far is returned.
+     */
+    double time_limit = std::numeric_limits<double>::infinity();
+
+    /**
+     * Directory where the reductions are cached.
+     *
+     * If empty, the reduction is always computed. Otherwise, a reduction
+     * previously computed for the same instance with the same parameters is
+     * loaded from this directory, and a newly computed reduction is stored
+     * in it.
+     */
+    std::string cache_directory = "";
 };
 
 class Reduction
@@ -41,12 +63,56 @@ public:
     Weight unreduce_bound(
             Weight bound) const;
 
+    /**
+     * Compute the key identifying the reduction of an instance in the cache.
+     *
+     * The key is a hash of the content of the instance and of the parameters
+     * which have an impact on the reduction.
+     */
+    static uint64_t cache_key(
+            const Instance& instance,
+            const ReductionParameters& parameters);
+
 private:
 
     /*
      * Private methods
      */
 
+    /** Compute the reduction. */
+    void reduce(
+            const ReductionParameters& parameters);
+
+    /**
+     * Read a reduction from a cache file.
+     *
+     * Return 'false' if the file doesn't exist or doesn't correspond to the
+     * original instance.
+     */
+    bool read(
+            const std::string& cache_path,
+            uint64_t key);
+
+    /**
+     * Write the reduction to a cache file.
+     *
+     * Return 'false' if the file couldn't be written.
+     */
+    bool write(
+            const std::string& cache_path,
+            uint64_t key) const;
+
+    /** Return 'true' if the time limit of the reduction has been reached. */
+    bool needs_to_end();
+
+    /**
+     * Add a node to the unreduction log.
+     *
+     * Return the id of the new node.
+     */
+    VertexId add_unreduction_node(
+            std::initializer_list<VertexId> literals);
+
     /**
      * Perform pendant vertices reduction.
      *
@@ -136,29 +202,42 @@ private:
     /** Reduced instance. */
     Instance instance_;
 
+    /** Time at which the reduction must stop. */
+    std::chrono::steady_clock::time_point end_time_;
+
+    /** Boolean indicating if the reduction has been stopped by the time limit. */
+    bool interrupted_ = false;
+
+    /*
+     * Unreduction log.
+     *
+     * Each vertex of the reduced instance corresponds to a node of the
+     * unreduction log. Nodes 0 to n - 1, where n is the number of vertices of
+     * the original instance, are the vertices of the original instance. The
+     * other nodes are created when some vertices are folded into a single
+     * vertex; they are appended to the log and never modified afterwards.
+     *
+     * A node is referenced through a literal: 'node_id' if the children take
+     * the same state as the node, '~node_id' if they take the opposite state.
+     */
+
+    /** For each vertex of the reduced instance, its node. */
+    std::vector<VertexId> vertex_nodes_;
+
     /**
-     * Structure that stores the unreduction operation for a considered vertex.
-     */
-    struct UnreductionOperations
-    {
-        /**
-         * List of vertices from the original graph to add if the considered vertex
-         * is in the solution of the reduced instance.
-         */
-        std::vector<VertexId> in;
-
-        /**
-         * List of vertices from the original graph to add if the considered vertex
-         * is NOT in the solution of the reduced instance.
-         */
-        std::vector<VertexId> out;
-    };
-
-    /** For each vertex, unreduction operations. */
-    std::vector<UnreductionOperations> unreduction_operations_;
-
-    /** Mandatory vertices (from the original instance). */
-    std::vector<VertexId> mandatory_vertices_;
+     * For each node created by a reduction, position of its first child in
+     * 'unreduction_children_'.
+     */
+    std::vector<VertexId> unreduction_children_starts_ = {0};
+
+    /** Children of the nodes created by a reduction, as literals. */
+    std::vector<VertexId> unreduction_children_;
+
+    /**
+     * Literals of the nodes fixed by a reduction; '~node_id' if the node is
+     * fixed out of the solution.
+     */
+    std::vector<VertexId> fixed_literals_;
 
     /**
      * Weight to add to a solution of the reduced instance to get the weight of
@@ -2,7 +2,7 @@
 
 #include "stablesolver/clique/algorithm_formatter.hpp"
 
-#include "optimizationtools/containers/doubly_indexed_map.hpp"
+#include "optimizationtools/containers/indexed_binary_heap.hpp"
 
 using namespace stablesolver::clique;
 
@@ -63,36 +63,75 @@ const Output stablesolver::clique::greedy_strong(
     const optimizationtools::AbstractGraph* graph = instance.graph();
     Solution solution(instance);
 
-    optimizationtools::DoublyIndexedMap candidates(
-            graph->number_of_vertices(), graph->number_of_vertices());
+    // The candidates are the vertices adjacent to all the vertices of the
+    // solution. The score of a candidate is the total weight of its
+    // neighbors which are candidates.
+    std::vector<Weight> scores(graph->number_of_vertices(), 0);
     for (VertexId vertex_id = 0;
             vertex_id < graph->number_of_vertices();
-            ++vertex_id)
-        candidates.set(vertex_id, 0);
-    while (candidates.number_of_elements(solution.number_of_vertices()) > 0) {
-        VertexId vertex_id_best = -1;
-        VertexPos score_best = -1;
-        for (auto it_v = candidates.begin(solution.number_of_vertices());
-                it_v != candidates.end(solution.number_of_vertices());
-                ++it_v) {
-            VertexId vertex_id = *it_v;
-            VertexPos score = 0;
-            for (auto it = graph->neighbors_begin(vertex_id);
-                    it != graph->neighbors_end(vertex_id);
-                    ++it) {
-                if (candidates.contains(*it))
-                    score += graph->weight(*it);
-            }
-            if (vertex_id_best == -1 || score_best < score) {
-                vertex_id_best = vertex_id;
-                score_best = score;
+            ++vertex_id) {
+        for (auto it = graph->neighbors_begin(vertex_id);
+                it != graph->neighbors_end(vertex_id);
+                ++it) {
+            scores[vertex_id] += graph->weight(*it);
+        }
+    }
+    // The heap is a min-heap, so the scores are negated.
+    auto f = [&scores](VertexId vertex_id)
+    {
+        return std::pair<Weight, VertexId>{-scores[vertex_id], vertex_id};
+    };
+    optimizationtools::IndexedBinaryHeap<std::pair<Weight, VertexId>> heap(graph->number_of_vertices(), f);
+
+    std::vector<VertexId> candidates(graph->number_of_vertices());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    std::vector<int8_t> is_candidate(graph->number_of_vertices(), 1);
+    std::vector<int8_t> is_neighbor(graph->number_of_vertices(), 0);
+    std::vector<VertexId> removed_vertices;
+    while (!heap.empty()) {
+        VertexId vertex_id = heap.top().first;
+        heap.pop();
+        solution.add(vertex_id);
+        is_candidate[vertex_id] = 0;
+
+        // Remove the candidates which are not neighbors of the vertex.
+        for (auto it = graph->neighbors_begin(vertex_id);
+                it != graph->neighbors_end(vertex_id);
+                ++it) {
+            is_neighbor[*it] = 1;
+        }
+        removed_vertices.clear();
+        VertexPos number_of_candidates = 0;
+        for (VertexId vertex_id_2: candidates) {
+            if (!is_candidate[vertex_id_2])
+                continue;
+            if (is_neighbor[vertex_id_2]) {
+                candidates[number_of_candidates] = vertex_id_2;
+                number_of_candidates++;
+            } else {
+                is_candidate[vertex_id_2] = 0;
+                heap.update_key(vertex_id_2, {std::numeric_limits<Weight>::lowest(), -1});
+                heap.pop();
+                removed_vertices.push_back(vertex_id_2);
             }
         }
-        solution.add(vertex_id_best);
-        for (auto it = graph->neighbors_begin(vertex_id_best);
-                it != graph->neighbors_end(vertex_id_best);
+        candidates.resize(number_of_candidates);
+        for (auto it = graph->neighbors_begin(vertex_id);
+                it != graph->neighbors_end(vertex_id);
                 ++it) {
-            candidates.set(*it, candidates[*it] + 1);
+            is_neighbor[*it] = 0;
+        }
+
+        // Update the scores of the remaining candidates.
+        for (VertexId vertex_id_2: removed_vertices) {
+            for (auto it = graph->neighbors_begin(vertex_id_2);
+                    it != graph->neighbors_end(vertex_id_2);
+                    ++it) {
+                if (!is_candidate[*it])
+                    continue;
+                scores[*it] -= graph->weight(vertex_id_2);
+                heap.update_key(*it, f(*it));
+            }
         }
     }
     algorithm_formatter.update_solution(solution, "");
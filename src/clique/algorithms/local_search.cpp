@@ -27,6 +27,12 @@ public:
         /** Enable (2-1)-swap neighborhood. */
         bool swap_2_1 = true;
         bool shuffle_neighborhood_order = true;
+
+        /**
+         * Number of perturbations generated by 'perturbations'; -1 for one
+         * perturbation per vertex.
+         */
+        Counter number_of_perturbations = -1;
     };
 
     LocalScheme(
@@ -37,10 +43,20 @@ public:
         relevant_vertices_(instance.graph()->number_of_vertices()),
         tight_vertices_(instance.graph()->number_of_vertices(), -1),
         neighbors_(instance_.graph()->number_of_vertices()),
-        neighbors_2_(instance_.graph()->number_of_vertices())
+        neighbors_2_(instance_.graph()->number_of_vertices()),
+        perturbation_vertices_(instance_.graph()->number_of_vertices()),
+        zobrist_keys_(instance_.graph()->number_of_vertices())
     {
         // Initialize relevant_vertices_.
         relevant_vertices_.fill();
+
+        // Initialize zobrist_keys_.
+        std::mt19937_64 generator(0);
+        for (VertexId vertex_id = 0;
+                vertex_id < instance_.graph()->number_of_vertices();
+                ++vertex_id) {
+            zobrist_keys_[vertex_id] = generator();
+        }
     }
 
     /*
@@ -66,6 +82,9 @@ public:
         optimizationtools::IndexedSet vertices;
         std::vector<Weight> addition_costs;
         Weight weight = 0;
+
+        /** Zobrist hash of the solution. */
+        uint64_t hash = 0;
     };
 
     inline Solution empty_solution() const
@@ -280,16 +299,40 @@ public:
 
     inline std::vector<Perturbation> perturbations(
             const Solution& solution,
-            std::mt19937_64&)
+            std::mt19937_64& generator)
     {
         std::vector<Perturbation> perturbations;
-        for (VertexId vertex_id: relevant_vertices_) {
-            GlobalCost c = (contains(solution, vertex_id))?
-                cost_remove(solution, vertex_id, localsearchsolver::worst<GlobalCost>()):
-                cost_add(solution, vertex_id, localsearchsolver::worst<GlobalCost>());
+        Counter number_of_perturbations = parameters_.number_of_perturbations;
+        if (number_of_perturbations == -1
+                || number_of_perturbations >= (Counter)relevant_vertices_.size()) {
+            for (VertexId vertex_id: relevant_vertices_) {
+                Perturbation perturbation;
+                perturbation.vertex_id = vertex_id;
+                perturbation.global_cost = cost_perturbation(solution, vertex_id);
+                perturbations.push_back(perturbation);
+            }
+            return perturbations;
+        }
+
+        // Each perturbation is the best of two random vertices. The number of
+        // draws is bounded in case of many collisions.
+        perturbation_vertices_.clear();
+        std::uniform_int_distribution<VertexPos> distribution(0, relevant_vertices_.size() - 1);
+        for (Counter draw_id = 0;
+                draw_id < 4 * number_of_perturbations
+                && (Counter)perturbations.size() < number_of_perturbations;
+                ++draw_id) {
+            VertexId vertex_id_1 = *(relevant_vertices_.begin() + distribution(generator));
+            VertexId vertex_id_2 = *(relevant_vertices_.begin() + distribution(generator));
+            GlobalCost c_1 = cost_perturbation(solution, vertex_id_1);
+            GlobalCost c_2 = cost_perturbation(solution, vertex_id_2);
+            VertexId vertex_id = (c_2 < c_1)? vertex_id_2: vertex_id_1;
+            if (perturbation_vertices_.contains(vertex_id))
+                continue;
+            perturbation_vertices_.add(vertex_id);
             Perturbation perturbation;
             perturbation.vertex_id = vertex_id;
-            perturbation.global_cost = c;
+            perturbation.global_cost = (c_2 < c_1)? c_2: c_1;
             perturbations.push_back(perturbation);
         }
         return perturbations;
@@ -312,23 +355,36 @@ public:
      * Best first local search
      */
 
-    using CompactSolution = std::vector<bool>;
+    struct CompactSolution
+    {
+        /** Zobrist hash of the solution. */
+        uint64_t hash;
+
+        /** vertices[vertex_id] == true iff the vertex is in the solution. */
+        std::vector<bool> vertices;
+    };
 
+    /**
+     * Hasher of the compact solutions.
+     *
+     * The hash is maintained incrementally in the solution, so hashing a
+     * compact solution takes constant time, and the vertices are only
+     * compared when the hashes are equal.
+     */
     struct CompactSolutionHasher
     {
-        std::hash<CompactSolution> hasher;
-
         inline bool operator()(
                 const std::shared_ptr<CompactSolution>& compact_solution_1,
                 const std::shared_ptr<CompactSolution>& compact_solution_2) const
         {
-            return *compact_solution_1 == *compact_solution_2;
+            return compact_solution_1->hash == compact_solution_2->hash
+                && compact_solution_1->vertices == compact_solution_2->vertices;
         }
 
         inline std::size_t operator()(
                 const std::shared_ptr<CompactSolution>& compact_solution) const
         {
-            return hasher(*compact_solution);
+            return compact_solution->hash;
         }
     };
 
@@ -339,7 +395,7 @@ public:
         std::vector<bool> vertices(instance_.graph()->number_of_vertices(), false);
         for (VertexId vertex_id: solution.vertices)
             vertices[vertex_id] = true;
-        return vertices;
+        return {solution.hash, vertices};
     }
 
     Solution compact2solution(const CompactSolution& compact_solution)
@@ -349,7 +405,7 @@ public:
                 vertex_id < instance_.graph()->number_of_vertices();
                 ++vertex_id) {
             if (relevant_vertices_.contains(vertex_id))
-                if (compact_solution[vertex_id])
+                if (compact_solution.vertices[vertex_id])
                     add(solution, vertex_id);
         }
         return solution;
@@ -455,6 +511,7 @@ private:
 
         solution.vertices.add(vertex_id);
         solution.weight += weight;
+        solution.hash ^= zobrist_keys_[vertex_id];
         assert(solution.addition_costs[vertex_id] == 0);
     }
 
@@ -480,6 +537,7 @@ private:
 
         solution.vertices.remove(vertex_id);
         solution.weight -= weight;
+        solution.hash ^= zobrist_keys_[vertex_id];
         for (VertexId vertex_id_2: relevant_vertices_) {
             if (!neighbors_2_.contains(vertex_id_2)) {
                 solution.addition_costs[vertex_id_2] -= weight;
@@ -514,6 +572,16 @@ private:
         };
     }
 
+    /** Get the cost of the solution after adding or removing a vertex. */
+    inline GlobalCost cost_perturbation(
+            const Solution& solution,
+            VertexId vertex_id) const
+    {
+        return (contains(solution, vertex_id))?
+            cost_remove(solution, vertex_id, localsearchsolver::worst<GlobalCost>()):
+            cost_add(solution, vertex_id, localsearchsolver::worst<GlobalCost>());
+    }
+
     /*
      * Private attributes
      */
@@ -526,6 +594,10 @@ private:
     optimizationtools::IndexedMap<VertexId> tight_vertices_;
     mutable optimizationtools::IndexedSet neighbors_;
     mutable optimizationtools::IndexedSet neighbors_2_;
+    optimizationtools::IndexedSet perturbation_vertices_;
+
+    /** For each vertex, random key of the Zobrist hash of the solutions. */
+    std::vector<uint64_t> zobrist_keys_;
 
 };
 
@@ -543,6 +615,7 @@ const Output stablesolver::clique::local_search(
 
     // Create LocalScheme.
     LocalScheme::Parameters parameters_local_scheme;
+    parameters_local_scheme.number_of_perturbations = parameters.number_of_perturbations;
     LocalScheme local_scheme(instance, parameters_local_scheme);
 
     // Run A*.
@@ -64,6 +64,8 @@ Output run(
     } else if (algorithm == "local-search") {
         LocalSearchParameters parameters;
         read_args(parameters, vm);
+        if (vm.count("number-of-perturbations"))
+            parameters.number_of_perturbations = vm["number-of-perturbations"].as<int>();
         return local_search(instance, generator, parameters);
 
     } else {
@@ -95,6 +97,7 @@ int main(int argc, char *argv[])
 
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement")
+        ("number-of-perturbations,", po::value<int>(), "set the number of perturbations generated at each node of the local search")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -0,0 +1,146 @@
+#include "stablesolver/stable/instance_builder.hpp"
+#include "stablesolver/stable/algorithms/local_search.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <numeric>
+#include <string>
+
+using namespace stablesolver;
+using namespace stablesolver::stable;
+namespace po = boost::program_options;
+
+namespace
+{
+
+/**
+ * Vertex of a solution stored as an array of structures, as in the previous
+ * layout of the local search solutions. Used as a reference.
+ */
+struct SolutionVertex
+{
+    bool in = false;
+    Weight neighbor_weight = 0;
+};
+
+/**
+ * Run a function repeatedly for at least 'duration' seconds and return the
+ * number of runs per second.
+ */
+template <typename Function>
+double runs_per_second(
+        Function function,
+        double duration)
+{
+    auto start = std::chrono::steady_clock::now();
+    Counter number_of_runs = 0;
+    double elapsed_time = 0;
+    while (elapsed_time < duration) {
+        function();
+        number_of_runs++;
+        elapsed_time = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+    }
+    return number_of_runs / elapsed_time;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // Parse program options
+    po::options_description desc("Allowed options");
+    desc.add_options()
+        (",h", "Produce help message")
+        ("input,i", po::value<std::string>()->required(), "set input path")
+        ("format,f", po::value<std::string>()->default_value(""), "set input format")
+        ("duration,", po::value<double>()->default_value(1.0), "set the duration of each measure in seconds")
+        ("seed,s", po::value<Seed>()->default_value(0), "set seed")
+        ;
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;;
+        return 1;
+    }
+    try {
+        po::notify(vm);
+    } catch (const po::required_option& e) {
+        std::cout << desc << std::endl;;
+        return 1;
+    }
+
+    // Build instance.
+    InstanceBuilder instance_builder;
+    instance_builder.read(
+            vm["input"].as<std::string>(),
+            vm["format"].as<std::string>());
+    Instance instance = instance_builder.build();
+    VertexId number_of_vertices = instance.number_of_vertices();
+    double duration = vm["duration"].as<double>();
+
+    // Build a random maximal solution.
+    std::mt19937_64 generator(vm["seed"].as<Seed>());
+    std::vector<VertexId> vertices(number_of_vertices);
+    std::iota(vertices.begin(), vertices.end(), 0);
+    std::shuffle(vertices.begin(), vertices.end(), generator);
+    std::vector<Weight> weights(number_of_vertices);
+    std::vector<int8_t> in(number_of_vertices, 0);
+    std::vector<Weight> neighbor_weights(number_of_vertices, 0);
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        weights[vertex_id] = instance.vertex(vertex_id).weight;
+    for (VertexId vertex_id: vertices) {
+        if (neighbor_weights[vertex_id] != 0)
+            continue;
+        in[vertex_id] = 1;
+        for (const VertexEdge& edge: instance.vertex(vertex_id).edges)
+            neighbor_weights[edge.vertex_id] += weights[vertex_id];
+    }
+    std::vector<SolutionVertex> solution_vertices(number_of_vertices);
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+        solution_vertices[vertex_id].in = in[vertex_id];
+        solution_vertices[vertex_id].neighbor_weight = neighbor_weights[vertex_id];
+    }
+
+    std::vector<Weight> gains(number_of_vertices);
+    Weight checksum = 0;
+
+    // Array of structures, scalar loop. The weights are read from the same
+    // array as in the vectorized kernel, so that only the layout of the
+    // solution differs.
+    double aos_runs_per_second = runs_per_second(
+            [&weights, &solution_vertices, &gains, &checksum, number_of_vertices]()
+            {
+                for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+                    gains[vertex_id] = (solution_vertices[vertex_id].in)?
+                        -weights[vertex_id]:
+                        weights[vertex_id]
+                        - solution_vertices[vertex_id].neighbor_weight;
+                }
+                checksum += gains[number_of_vertices / 2];
+            },
+            duration);
+
+    // Structure of arrays, vectorized kernel.
+    double soa_runs_per_second = runs_per_second(
+            [&weights, &neighbor_weights, &in, &gains, &checksum, number_of_vertices]()
+            {
+                compute_add_gains(
+                        number_of_vertices,
+                        weights.data(),
+                        neighbor_weights.data(),
+                        in.data(),
+                        gains.data());
+                checksum += gains[number_of_vertices / 2];
+            },
+            duration);
+
+    std::cout << "Number of vertices:              " << number_of_vertices << std::endl;
+    std::cout << "Checksum:                        " << checksum << std::endl;
+    std::cout << "Array of structures (evals/s):   " << aos_runs_per_second * number_of_vertices << std::endl;
+    std::cout << "Structure of arrays (evals/s):   " << soa_runs_per_second * number_of_vertices << std::endl;
+    std::cout << "Speedup:                         " << soa_runs_per_second / aos_runs_per_second << std::endl;
+
+    return 0;
+}
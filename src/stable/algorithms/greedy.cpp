@@ -4,8 +4,64 @@
 
 #include "optimizationtools/containers/indexed_binary_heap.hpp"
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 using namespace stablesolver::stable;
 
+namespace
+{
+
+/**
+ * Call 'function(first, last)' on consecutive ranges splitting [0, size), one
+ * per thread.
+ */
+template <typename Function>
+void parallel_for(
+        Counter number_of_threads,
+        Counter size,
+        const Function& function)
+{
+    if (number_of_threads <= 1) {
+        function(0, size);
+        return;
+    }
+    std::vector<std::exception_ptr> exceptions(number_of_threads, nullptr);
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 0; thread_id < number_of_threads; ++thread_id) {
+        Counter first = size * thread_id / number_of_threads;
+        Counter last = size * (thread_id + 1) / number_of_threads;
+        threads.push_back(std::thread([&function, &exceptions, thread_id, first, last]()
+                    {
+                        try {
+                            function(first, last);
+                        } catch (...) {
+                            exceptions[thread_id] = std::current_exception();
+                        }
+                    }));
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+    for (const std::exception_ptr& exception: exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
+}
+
+/** Hash a vertex with a seed (splitmix64 finalizer). */
+uint64_t vertex_hash(
+        Seed seed,
+        VertexId vertex_id)
+{
+    uint64_t z = (uint64_t)seed + 0x9e3779b97f4a7c15ULL * ((uint64_t)vertex_id + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+}
+
 const Output stablesolver::stable::greedy_gwmin(
         const Instance& instance,
         const GreedyParameters& parameters)
@@ -18,33 +74,62 @@ const Output stablesolver::stable::greedy_gwmin(
     if (parameters.reduction_parameters.reduce)
         return solve_reduced_instance(greedy_gwmin, instance, parameters, algorithm_formatter, output);
 
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(greedy_gwmin, instance, parameters, algorithm_formatter, output);
+
     algorithm_formatter.print_header();
 
-    Solution solution(instance);
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
 
-    std::vector<double> vertices_values(instance.number_of_vertices(), 0);
+    // The priority of a vertex is its weight divided by its residual degree
+    // plus one. The heap is a min-heap, so the priorities are negated.
+    std::vector<VertexId> residual_degrees(instance.number_of_vertices());
     for (VertexId vertex_id = 0;
             vertex_id < instance.number_of_vertices();
             ++vertex_id) {
-        vertices_values[vertex_id] = (double)instance.vertex(vertex_id).weight
-            / (instance.degree(vertex_id) + 1);
+        residual_degrees[vertex_id] = instance.degree(vertex_id);
     }
+    auto f = [&instance, &residual_degrees](VertexId vertex_id)
+    {
+        double val = (double)instance.vertex(vertex_id).weight
+            / (residual_degrees[vertex_id] + 1);
+        return std::pair<double, VertexId>{-val, vertex_id};
+    };
+    optimizationtools::IndexedBinaryHeap<std::pair<double, VertexId>> heap(instance.number_of_vertices(), f);
 
-    std::vector<VertexId> sorted_vertices(instance.number_of_vertices(), 0);
-    std::iota(sorted_vertices.begin(), sorted_vertices.end(), 0);
-    std::sort(sorted_vertices.begin(), sorted_vertices.end(),
-            [&vertices_values](VertexId vertex_id_1, VertexId vertex_id_2) -> bool
-        {
-            return vertices_values[vertex_id_1] > vertices_values[vertex_id_2];
-        });
-
+    Solution solution(instance);
     std::vector<int8_t> available_vertices(instance.number_of_vertices(), 1);
-    for (VertexId vertex_id: sorted_vertices) {
-        if (!available_vertices[vertex_id])
-            continue;
+    std::vector<VertexId> removed_vertices;
+    while (!heap.empty()) {
+        VertexId vertex_id = heap.top().first;
+        heap.pop();
         solution.add(vertex_id);
-        for (const auto& edge: instance.vertex(vertex_id).edges)
+        available_vertices[vertex_id] = 0;
+
+        // Remove the neighbors of the vertex.
+        removed_vertices.clear();
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (!available_vertices[edge.vertex_id])
+                continue;
             available_vertices[edge.vertex_id] = 0;
+            heap.update_key(edge.vertex_id, {-std::numeric_limits<double>::infinity(), -1});
+            heap.pop();
+            removed_vertices.push_back(edge.vertex_id);
+        }
+
+        // Update the residual degrees of the vertices which are still
+        // available.
+        for (VertexId vertex_id_2: removed_vertices) {
+            for (const auto& edge: instance.vertex(vertex_id_2).edges) {
+                if (!available_vertices[edge.vertex_id])
+                    continue;
+                residual_degrees[edge.vertex_id]--;
+                heap.update_key(edge.vertex_id, f(edge.vertex_id));
+            }
+        }
     }
     algorithm_formatter.update_solution(solution, "");
 
@@ -64,8 +149,16 @@ const Output stablesolver::stable::greedy_gwmax(
     if (parameters.reduction_parameters.reduce)
         return solve_reduced_instance(greedy_gwmax, instance, parameters, algorithm_formatter, output);
 
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(greedy_gwmax, instance, parameters, algorithm_formatter, output);
+
     algorithm_formatter.print_header();
 
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
     auto f = [&instance](VertexId vertex_id)
     {
         VertexId d = instance.degree(vertex_id);
@@ -121,8 +214,16 @@ const Output stablesolver::stable::greedy_gwmin2(
     if (parameters.reduction_parameters.reduce)
         return solve_reduced_instance(greedy_gwmin2, instance, parameters, algorithm_formatter, output);
 
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(greedy_gwmin2, instance, parameters, algorithm_formatter, output);
+
     algorithm_formatter.print_header();
 
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
     Solution solution(instance);
 
     std::vector<double> vertices_values(instance.number_of_vertices(), 0);
@@ -171,32 +272,500 @@ const Output stablesolver::stable::greedy_strong(
     if (parameters.reduction_parameters.reduce)
         return solve_reduced_instance(greedy_strong, instance, parameters, algorithm_formatter, output);
 
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(greedy_strong, instance, parameters, algorithm_formatter, output);
+
     algorithm_formatter.print_header();
 
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    // The score of a vertex is the total weight of its available neighbors.
+    std::vector<Weight> scores(instance.number_of_vertices(), 0);
+    for (VertexId vertex_id = 0;
+            vertex_id < instance.number_of_vertices();
+            ++vertex_id) {
+        for (const auto& edge: instance.vertex(vertex_id).edges)
+            scores[vertex_id] += instance.vertex(edge.vertex_id).weight;
+    }
+    auto f = [&scores](VertexId vertex_id)
+    {
+        return std::pair<Weight, VertexId>{scores[vertex_id], vertex_id};
+    };
+    optimizationtools::IndexedBinaryHeap<std::pair<Weight, VertexId>> heap(instance.number_of_vertices(), f);
+
     Solution solution(instance);
+    std::vector<int8_t> available_vertices(instance.number_of_vertices(), 1);
+    std::vector<VertexId> removed_vertices;
+    while (!heap.empty()) {
+        VertexId vertex_id = heap.top().first;
+        heap.pop();
+        solution.add(vertex_id);
+        available_vertices[vertex_id] = 0;
+
+        // Remove the neighbors of the vertex.
+        removed_vertices.clear();
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (!available_vertices[edge.vertex_id])
+                continue;
+            available_vertices[edge.vertex_id] = 0;
+            heap.update_key(edge.vertex_id, {std::numeric_limits<Weight>::lowest(), -1});
+            heap.pop();
+            removed_vertices.push_back(edge.vertex_id);
+        }
 
-    optimizationtools::IndexedSet candidates(instance.number_of_vertices());
-    candidates.fill();
-    while (candidates.size() > 0) {
-        VertexId vertex_id_best = -1;
-        VertexPos score_best = -1;
-        for (VertexId vertex_id: candidates) {
-            VertexPos score = 0;
-            for (auto edge: instance.vertex(vertex_id).edges)
-                if (candidates.contains(edge.vertex_id))
-                    score -= instance.vertex(edge.vertex_id).weight;
-            if (vertex_id_best == -1 || score_best < score) {
-                vertex_id_best = vertex_id;
-                score_best = score;
+        // Update the scores of the vertices which are still available.
+        for (VertexId vertex_id_2: removed_vertices) {
+            for (const auto& edge: instance.vertex(vertex_id_2).edges) {
+                if (!available_vertices[edge.vertex_id])
+                    continue;
+                scores[edge.vertex_id] -= instance.vertex(vertex_id_2).weight;
+                heap.update_key(edge.vertex_id, f(edge.vertex_id));
             }
         }
-        solution.add(vertex_id_best);
-        candidates.remove(vertex_id_best);
-        for (auto edge: instance.vertex(vertex_id_best).edges)
-            candidates.remove(edge.vertex_id);
     }
     algorithm_formatter.update_solution(solution, "");
 
     algorithm_formatter.end();
     return output;
 }
+
+const Output stablesolver::stable::greedy_parallel(
+        const Instance& instance,
+        const GreedyParallelParameters& parameters)
+{
+    Output output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Parallel greedy");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce)
+        return solve_reduced_instance(greedy_parallel, instance, parameters, algorithm_formatter, output);
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(greedy_parallel, instance, parameters, algorithm_formatter, output);
+
+    algorithm_formatter.print_header();
+
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    VertexId number_of_vertices = instance.number_of_vertices();
+    Counter number_of_threads = (std::max)((Counter)1, (std::min)(
+                parameters.number_of_threads,
+                (Counter)number_of_vertices / 1024 + 1));
+
+    // Compute the priorities.
+    std::vector<std::pair<double, uint64_t>> priorities(number_of_vertices);
+    parallel_for(number_of_threads, number_of_vertices, [&instance, &parameters, &priorities](
+                Counter first,
+                Counter last)
+            {
+                for (VertexId vertex_id = first; vertex_id < last; ++vertex_id) {
+                    priorities[vertex_id] = {
+                        (double)instance.vertex(vertex_id).weight / (instance.degree(vertex_id) + 1),
+                        vertex_hash(parameters.seed, vertex_id)};
+                }
+            });
+    auto compare = [&priorities](VertexId vertex_id_1, VertexId vertex_id_2) -> bool
+    {
+        if (priorities[vertex_id_1] != priorities[vertex_id_2])
+            return priorities[vertex_id_1] > priorities[vertex_id_2];
+        return vertex_id_1 < vertex_id_2;
+    };
+
+    // Sort the vertices: sort one chunk per thread, then merge the chunks
+    // pairwise.
+    std::vector<VertexId> sorted_vertices(number_of_vertices);
+    std::iota(sorted_vertices.begin(), sorted_vertices.end(), 0);
+    std::vector<VertexId> chunk_starts(number_of_threads + 1);
+    for (Counter thread_id = 0; thread_id <= number_of_threads; ++thread_id)
+        chunk_starts[thread_id] = (Counter)number_of_vertices * thread_id / number_of_threads;
+    parallel_for(number_of_threads, number_of_threads, [&sorted_vertices, &chunk_starts, &compare](
+                Counter first,
+                Counter last)
+            {
+                for (Counter chunk_id = first; chunk_id < last; ++chunk_id) {
+                    std::sort(
+                            sorted_vertices.begin() + chunk_starts[chunk_id],
+                            sorted_vertices.begin() + chunk_starts[chunk_id + 1],
+                            compare);
+                }
+            });
+    while (chunk_starts.size() > 2) {
+        Counter number_of_merges = (chunk_starts.size() - 1) / 2;
+        parallel_for(number_of_merges, number_of_merges, [&sorted_vertices, &chunk_starts, &compare](
+                    Counter first,
+                    Counter last)
+                {
+                    for (Counter merge_id = first; merge_id < last; ++merge_id) {
+                        std::inplace_merge(
+                                sorted_vertices.begin() + chunk_starts[2 * merge_id],
+                                sorted_vertices.begin() + chunk_starts[2 * merge_id + 1],
+                                sorted_vertices.begin() + chunk_starts[2 * merge_id + 2],
+                                compare);
+                    }
+                });
+        std::vector<VertexId> new_chunk_starts;
+        for (Counter pos = 0; pos < (Counter)chunk_starts.size(); pos += 2)
+            new_chunk_starts.push_back(chunk_starts[pos]);
+        if (new_chunk_starts.back() != number_of_vertices)
+            new_chunk_starts.push_back(number_of_vertices);
+        chunk_starts.swap(new_chunk_starts);
+    }
+
+    // 0: undecided; 1: in the solution; 2: not in the solution.
+    std::vector<int8_t> statuses(number_of_vertices, 0);
+    if (number_of_threads == 1) {
+        for (VertexId vertex_id: sorted_vertices) {
+            if (statuses[vertex_id] != 0)
+                continue;
+            statuses[vertex_id] = 1;
+            for (const auto& edge: instance.vertex(vertex_id).edges)
+                statuses[edge.vertex_id] = 2;
+        }
+    } else {
+        std::vector<VertexId> ranks(number_of_vertices);
+        parallel_for(number_of_threads, number_of_vertices, [&sorted_vertices, &ranks](
+                    Counter first,
+                    Counter last)
+                {
+                    for (VertexPos rank = first; rank < last; ++rank)
+                        ranks[sorted_vertices[rank]] = rank;
+                });
+
+        // The vertices outside of the prefix are all undecided, and have a
+        // lower priority than the vertices in it.
+        VertexPos prefix_size = (std::max)((VertexPos)1024, number_of_vertices / 64);
+        std::vector<VertexId> prefix;
+        std::vector<int8_t> new_statuses(number_of_vertices, 0);
+        VertexPos rank_next = 0;
+        while (!prefix.empty() || rank_next < number_of_vertices) {
+            while ((VertexPos)prefix.size() < prefix_size
+                    && rank_next < number_of_vertices) {
+                prefix.push_back(sorted_vertices[rank_next]);
+                rank_next++;
+            }
+
+            // Decide the vertices of the prefix. Each thread only writes the
+            // new statuses of its own vertices.
+            Counter number_of_round_threads = (std::min)(
+                    number_of_threads,
+                    (Counter)prefix.size() / 1024 + 1);
+            parallel_for(number_of_round_threads, prefix.size(), [&instance, &statuses, &new_statuses, &ranks, &prefix](
+                        Counter first,
+                        Counter last)
+                    {
+                        for (VertexPos pos = first; pos < last; ++pos) {
+                            VertexId vertex_id = prefix[pos];
+                            int8_t status = 1;
+                            for (const auto& edge: instance.vertex(vertex_id).edges) {
+                                int8_t neighbor_status = statuses[edge.vertex_id];
+                                if (neighbor_status == 1) {
+                                    status = 2;
+                                    break;
+                                }
+                                if (neighbor_status == 0
+                                        && ranks[edge.vertex_id] < ranks[vertex_id]) {
+                                    status = 0;
+                                }
+                            }
+                            new_statuses[vertex_id] = status;
+                        }
+                    });
+
+            // Apply the new statuses and remove the decided vertices from
+            // the prefix.
+            VertexPos size = 0;
+            for (VertexId vertex_id: prefix) {
+                statuses[vertex_id] = new_statuses[vertex_id];
+                if (statuses[vertex_id] == 0) {
+                    prefix[size] = vertex_id;
+                    size++;
+                }
+            }
+            VertexPos number_of_decided_vertices = prefix.size() - size;
+            prefix.resize(size);
+
+            // If the round decided few vertices, the dependency chains are
+            // long and the next rounds wouldn't pay for their threads.
+            // Decide the remaining vertices sequentially, in the order of
+            // their ranks. A vertex of the prefix may still have a neighbor
+            // in the solution.
+            if (number_of_decided_vertices < 1024) {
+                auto decide = [&instance, &statuses](VertexId vertex_id)
+                {
+                    if (statuses[vertex_id] != 0)
+                        return;
+                    statuses[vertex_id] = 1;
+                    for (const auto& edge: instance.vertex(vertex_id).edges) {
+                        if (statuses[edge.vertex_id] == 1) {
+                            statuses[vertex_id] = 2;
+                            return;
+                        }
+                    }
+                    for (const auto& edge: instance.vertex(vertex_id).edges)
+                        statuses[edge.vertex_id] = 2;
+                };
+                for (VertexId vertex_id: prefix)
+                    decide(vertex_id);
+                for (; rank_next < number_of_vertices; ++rank_next)
+                    decide(sorted_vertices[rank_next]);
+                prefix.clear();
+            }
+        }
+    }
+
+    Solution solution(instance);
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        if (statuses[vertex_id] == 1)
+            solution.add(vertex_id);
+    algorithm_formatter.update_solution(solution, "");
+
+    algorithm_formatter.end();
+    return output;
+}
+
+namespace
+{
+
+/**
+ * Structure that stores the buffers of a thread of the multi-start greedy,
+ * so that restarts don't allocate memory.
+ */
+struct GreedyMultistartScratch
+{
+    GreedyMultistartScratch(VertexId number_of_vertices):
+        factors(number_of_vertices),
+        residual_degrees(number_of_vertices),
+        neighbors_weights(number_of_vertices),
+        available_vertices(number_of_vertices),
+        heap(number_of_vertices)
+    {
+        removed_vertices.reserve(number_of_vertices);
+        vertices.reserve(number_of_vertices);
+    }
+
+    /** Random factor of the priority of each vertex. */
+    std::vector<double> factors;
+
+    /** Number of available neighbors of each vertex. */
+    std::vector<VertexId> residual_degrees;
+
+    /** Total weight of the available neighbors of each vertex. */
+    std::vector<Weight> neighbors_weights;
+
+    /** For each vertex, 1 iff it is still available. */
+    std::vector<int8_t> available_vertices;
+
+    /** Priority queue of the available vertices. */
+    optimizationtools::IndexedBinaryHeap<std::pair<double, VertexId>> heap;
+
+    /** Vertices removed during the current step. */
+    std::vector<VertexId> removed_vertices;
+
+    /** Vertices of the current solution. */
+    std::vector<VertexId> vertices;
+};
+
+/** Criteria of the multi-start greedy. */
+enum class GreedyCriterion { Gwmin, Gwmin2, Gwmax };
+
+/**
+ * Run a randomized greedy on the buffers of 'scratch'.
+ *
+ * Return the weight of the solution, whose vertices are in
+ * 'scratch.vertices'.
+ */
+Weight greedy_randomized(
+        const Instance& instance,
+        GreedyCriterion criterion,
+        GreedyMultistartScratch& scratch)
+{
+    VertexId number_of_vertices = instance.number_of_vertices();
+
+    // The heap is a min-heap. For GWMIN and GWMIN2, it contains the
+    // candidate vertices to add, with negated priorities; for GWMAX, it
+    // contains the candidate vertices to remove.
+    auto f = [&instance, &scratch, criterion](VertexId vertex_id)
+    {
+        Weight weight = instance.vertex(vertex_id).weight;
+        VertexId d = scratch.residual_degrees[vertex_id];
+        double val = 0.0;
+        switch (criterion) {
+        case GreedyCriterion::Gwmin:
+            val = -(double)weight / (d + 1);
+            break;
+        case GreedyCriterion::Gwmin2:
+            val = (scratch.neighbors_weights[vertex_id] != 0)?
+                -(double)weight / scratch.neighbors_weights[vertex_id]:
+                -std::numeric_limits<double>::infinity();
+            break;
+        case GreedyCriterion::Gwmax:
+            val = (d != 0)?
+                (double)weight / d / (d + 1):
+                std::numeric_limits<double>::infinity();
+            break;
+        }
+        return std::pair<double, VertexId>{val * scratch.factors[vertex_id], vertex_id};
+    };
+
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+        scratch.residual_degrees[vertex_id] = instance.degree(vertex_id);
+        scratch.neighbors_weights[vertex_id] = 0;
+        for (const auto& edge: instance.vertex(vertex_id).edges)
+            scratch.neighbors_weights[vertex_id] += instance.vertex(edge.vertex_id).weight;
+        scratch.available_vertices[vertex_id] = 1;
+    }
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        scratch.heap.update_key(vertex_id, f(vertex_id));
+
+    // Update the priorities of the available neighbors of a removed vertex.
+    auto update_neighbors = [&instance, &scratch, &f](VertexId vertex_id)
+    {
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (!scratch.available_vertices[edge.vertex_id])
+                continue;
+            scratch.residual_degrees[edge.vertex_id]--;
+            scratch.neighbors_weights[edge.vertex_id] -= instance.vertex(vertex_id).weight;
+            scratch.heap.update_key(edge.vertex_id, f(edge.vertex_id));
+        }
+    };
+
+    scratch.vertices.clear();
+    Weight weight = 0;
+    if (criterion == GreedyCriterion::Gwmax) {
+        while (!scratch.heap.empty()) {
+            auto p = scratch.heap.top();
+            scratch.heap.pop();
+            if (p.second.first == std::numeric_limits<double>::infinity()) {
+                // Isolated vertex.
+                scratch.available_vertices[p.first] = 2;
+                continue;
+            }
+            scratch.available_vertices[p.first] = 0;
+            update_neighbors(p.first);
+        }
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+            if (scratch.available_vertices[vertex_id]) {
+                scratch.vertices.push_back(vertex_id);
+                weight += instance.vertex(vertex_id).weight;
+            }
+        }
+    } else {
+        while (!scratch.heap.empty()) {
+            VertexId vertex_id = scratch.heap.top().first;
+            scratch.heap.pop();
+            scratch.vertices.push_back(vertex_id);
+            weight += instance.vertex(vertex_id).weight;
+            scratch.available_vertices[vertex_id] = 0;
+
+            // Remove the neighbors of the vertex.
+            scratch.removed_vertices.clear();
+            for (const auto& edge: instance.vertex(vertex_id).edges) {
+                if (!scratch.available_vertices[edge.vertex_id])
+                    continue;
+                scratch.available_vertices[edge.vertex_id] = 0;
+                scratch.heap.update_key(edge.vertex_id, {-std::numeric_limits<double>::infinity(), -1});
+                scratch.heap.pop();
+                scratch.removed_vertices.push_back(edge.vertex_id);
+            }
+            for (VertexId vertex_id_2: scratch.removed_vertices)
+                update_neighbors(vertex_id_2);
+        }
+    }
+    return weight;
+}
+
+}
+
+const GreedyMultistartOutput stablesolver::stable::greedy_multistart(
+        const Instance& instance,
+        const GreedyMultistartParameters& parameters)
+{
+    GreedyMultistartOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Multi-start greedy");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce)
+        return solve_reduced_instance(greedy_multistart, instance, parameters, algorithm_formatter, output);
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(greedy_multistart, instance, parameters, algorithm_formatter, output);
+
+    algorithm_formatter.print_header();
+
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    VertexId number_of_vertices = instance.number_of_vertices();
+    Counter number_of_threads = (std::max)((Counter)1, (std::min)(
+                parameters.number_of_threads,
+                parameters.number_of_restarts));
+    std::atomic<Counter> restart_id_next(0);
+    std::exception_ptr exception = nullptr;
+    std::mutex mutex;
+    auto worker = [&]()
+    {
+        try {
+            GreedyMultistartScratch scratch(number_of_vertices);
+            for (;;) {
+                if (parameters.timer.needs_to_end())
+                    break;
+                Counter restart_id = restart_id_next++;
+                if (restart_id >= parameters.number_of_restarts)
+                    break;
+
+                // Draw the perturbation of the priorities. The first restart
+                // of each criterion isn't perturbed.
+                std::mt19937_64 generator(vertex_hash(parameters.seed, restart_id));
+                std::uniform_real_distribution<double> distribution(
+                        1 - parameters.noise,
+                        1 + parameters.noise);
+                for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+                    scratch.factors[vertex_id] = (restart_id < 3)?
+                        1.0: distribution(generator);
+                }
+                GreedyCriterion criterion = (restart_id % 3 == 0)? GreedyCriterion::Gwmin:
+                    (restart_id % 3 == 1)? GreedyCriterion::Gwmin2:
+                    GreedyCriterion::Gwmax;
+                Weight weight = greedy_randomized(instance, criterion, scratch);
+
+                // Update the best solution.
+                std::lock_guard<std::mutex> lock(mutex);
+                output.number_of_restarts++;
+                if (weight > output.solution.weight()) {
+                    Solution solution(instance);
+                    for (VertexId vertex_id: scratch.vertices)
+                        solution.add(vertex_id);
+                    std::stringstream ss;
+                    ss << "restart " << restart_id;
+                    algorithm_formatter.update_solution(solution, ss.str());
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!exception)
+                exception = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 1; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception)
+        std::rethrow_exception(exception);
+
+    algorithm_formatter.end();
+    return output;
+}
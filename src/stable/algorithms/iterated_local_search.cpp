@@ -0,0 +1,477 @@
+#include "stablesolver/stable/algorithms/iterated_local_search.hpp"
+
+#include "stablesolver/stable/algorithm_formatter.hpp"
+#include "stablesolver/stable/algorithms/greedy.hpp"
+
+#include "optimizationtools/containers/indexed_set.hpp"
+
+using namespace stablesolver::stable;
+
+namespace
+{
+
+/**
+ * Class that stores a solution together with the structures needed to
+ * evaluate the moves incrementally.
+ */
+class SwapLocalSearch
+{
+
+public:
+
+    /** Constructor. */
+    SwapLocalSearch(
+            const Instance& instance):
+        instance_(instance),
+        in_(instance.number_of_vertices(), 0),
+        tightnesses_(instance.number_of_vertices(), 0),
+        solution_neighbors_xor_(instance.number_of_vertices(), 0),
+        neighbor_weights_(instance.number_of_vertices(), 0),
+        improving_vertices_(instance.number_of_vertices()),
+        candidates_(instance.number_of_vertices()),
+        marks_(instance.number_of_vertices(), -1)
+    {
+        for (VertexId vertex_id = 0;
+                vertex_id < instance.number_of_vertices();
+                ++vertex_id) {
+            update_improving_vertices(vertex_id);
+        }
+    }
+
+    /** Get the weight of the solution. */
+    inline Weight weight() const { return weight_; }
+
+    /** Return 'true' iff the solution contains a vertex. */
+    inline bool contains(VertexId vertex_id) const { return in_[vertex_id]; }
+
+    /**
+     * Get the changes of the solution since the last call to
+     * 'start_recording'; '~vertex_id' for a removal.
+     */
+    inline const std::vector<VertexId>& log() const { return log_; }
+
+    /** Add a vertex to the solution and remove its neighbors. */
+    void force(VertexId vertex_id)
+    {
+        for (const VertexEdge& edge: instance_.vertex(vertex_id).edges)
+            if (in_[edge.vertex_id])
+                remove(edge.vertex_id);
+        add(vertex_id);
+    }
+
+    /**
+     * Apply improving moves until reaching a local optimum.
+     *
+     * The vertex 'tabu_vertex_id' is not removed from the solution.
+     *
+     * Return the number of moves.
+     */
+    Counter local_search(
+            std::mt19937_64& generator,
+            VertexId tabu_vertex_id);
+
+    /** Start recording the changes of the solution. */
+    void start_recording() { log_.clear(); }
+
+    /** Undo the changes recorded since the last call to 'start_recording'. */
+    void undo()
+    {
+        undo_log_.swap(log_);
+        for (auto it = undo_log_.rbegin(); it != undo_log_.rend(); ++it) {
+            if (*it >= 0) {
+                remove(*it);
+            } else {
+                add(~*it);
+            }
+        }
+        undo_log_.clear();
+        log_.clear();
+    }
+
+private:
+
+    /** Add a free vertex to the solution. */
+    void add(VertexId vertex_id);
+
+    /** Remove a vertex from the solution. */
+    void remove(VertexId vertex_id);
+
+    /** Update the membership of a vertex in 'improving_vertices_'. */
+    inline void update_improving_vertices(VertexId vertex_id)
+    {
+        if (!in_[vertex_id]
+                && instance_.vertex(vertex_id).weight > neighbor_weights_[vertex_id]) {
+            improving_vertices_.add(vertex_id);
+        } else {
+            improving_vertices_.remove(vertex_id);
+        }
+    }
+
+    /** Try to apply a (1,2)-swap removing the vertex from the solution. */
+    bool swap(VertexId vertex_id);
+
+    /** Instance. */
+    const Instance& instance_;
+
+    /** For each vertex, 1 iff it is in the solution. */
+    std::vector<int8_t> in_;
+
+    /** Weight of the solution. */
+    Weight weight_ = 0;
+
+    /** For each vertex, number of its neighbors in the solution. */
+    std::vector<VertexId> tightnesses_;
+
+    /**
+     * For each vertex, xor of its neighbors in the solution.
+     *
+     * For a 1-tight vertex, it is its neighbor in the solution.
+     */
+    std::vector<VertexId> solution_neighbors_xor_;
+
+    /** For each vertex, total weight of its neighbors in the solution. */
+    std::vector<Weight> neighbor_weights_;
+
+    /**
+     * Vertices which are not in the solution and are heavier than their
+     * neighbors in it, that is, vertices whose (ω,1)-swap is improving.
+     */
+    optimizationtools::IndexedSet improving_vertices_;
+
+    /**
+     * Improving vertices temporarily removed from 'improving_vertices_'
+     * because they are neighbors of the tabu vertex.
+     */
+    std::vector<VertexId> tabu_vertices_;
+
+    /** Vertices of the solution which have a new 1-tight neighbor. */
+    optimizationtools::IndexedSet candidates_;
+
+    /** Changes of the solution; '~vertex_id' for a removal. */
+    std::vector<VertexId> log_;
+
+    /** Changes being undone. */
+    std::vector<VertexId> undo_log_;
+
+    /** 1-tight neighbors of the current candidate. */
+    std::vector<VertexId> one_tight_vertices_;
+
+    /** Marks of the vertices, to test adjacency. */
+    std::vector<Counter> marks_;
+
+    /** Current mark. */
+    Counter mark_ = 0;
+
+};
+
+void SwapLocalSearch::add(VertexId vertex_id)
+{
+    assert(!in_[vertex_id]);
+    assert(tightnesses_[vertex_id] == 0);
+    in_[vertex_id] = 1;
+    Weight weight = instance_.vertex(vertex_id).weight;
+    weight_ += weight;
+    improving_vertices_.remove(vertex_id);
+    log_.push_back(vertex_id);
+    for (const VertexEdge& edge: instance_.vertex(vertex_id).edges) {
+        VertexId neighbor_id = edge.vertex_id;
+        tightnesses_[neighbor_id]++;
+        solution_neighbors_xor_[neighbor_id] ^= vertex_id;
+        neighbor_weights_[neighbor_id] += weight;
+        update_improving_vertices(neighbor_id);
+        if (tightnesses_[neighbor_id] == 1)
+            candidates_.add(vertex_id);
+    }
+}
+
+void SwapLocalSearch::remove(VertexId vertex_id)
+{
+    assert(in_[vertex_id]);
+    in_[vertex_id] = 0;
+    Weight weight = instance_.vertex(vertex_id).weight;
+    weight_ -= weight;
+    candidates_.remove(vertex_id);
+    update_improving_vertices(vertex_id);
+    log_.push_back(~vertex_id);
+    for (const VertexEdge& edge: instance_.vertex(vertex_id).edges) {
+        VertexId neighbor_id = edge.vertex_id;
+        tightnesses_[neighbor_id]--;
+        solution_neighbors_xor_[neighbor_id] ^= vertex_id;
+        neighbor_weights_[neighbor_id] -= weight;
+        update_improving_vertices(neighbor_id);
+        // With parallel edges, the neighbor may temporarily be 1-tight
+        // with the removed vertex.
+        if (tightnesses_[neighbor_id] == 1
+                && in_[solution_neighbors_xor_[neighbor_id]]) {
+            candidates_.add(solution_neighbors_xor_[neighbor_id]);
+        }
+    }
+}
+
+bool SwapLocalSearch::swap(VertexId vertex_id)
+{
+    Weight weight = instance_.vertex(vertex_id).weight;
+
+    // Get the 1-tight neighbors of the vertex, by non-increasing weight.
+    one_tight_vertices_.clear();
+    mark_++;
+    for (const VertexEdge& edge: instance_.vertex(vertex_id).edges) {
+        VertexId neighbor_id = edge.vertex_id;
+        if (tightnesses_[neighbor_id] != 1 || marks_[neighbor_id] == mark_)
+            continue;
+        marks_[neighbor_id] = mark_;
+        one_tight_vertices_.push_back(neighbor_id);
+    }
+    if (one_tight_vertices_.size() < 2)
+        return false;
+    std::sort(
+            one_tight_vertices_.begin(),
+            one_tight_vertices_.end(),
+            [this](VertexId vertex_id_1, VertexId vertex_id_2)
+            {
+                return instance_.vertex(vertex_id_1).weight
+                    > instance_.vertex(vertex_id_2).weight;
+            });
+
+    // For each 1-tight neighbor, its best partner is the heaviest
+    // non-adjacent 1-tight neighbor after it.
+    for (VertexPos pos_1 = 0;
+            pos_1 + 1 < (VertexPos)one_tight_vertices_.size();
+            ++pos_1) {
+        VertexId vertex_id_1 = one_tight_vertices_[pos_1];
+        Weight weight_1 = instance_.vertex(vertex_id_1).weight;
+        if (weight_1 + instance_.vertex(one_tight_vertices_[pos_1 + 1]).weight <= weight)
+            break;
+        mark_++;
+        for (const VertexEdge& edge: instance_.vertex(vertex_id_1).edges)
+            marks_[edge.vertex_id] = mark_;
+        for (VertexPos pos_2 = pos_1 + 1;
+                pos_2 < (VertexPos)one_tight_vertices_.size();
+                ++pos_2) {
+            VertexId vertex_id_2 = one_tight_vertices_[pos_2];
+            if (weight_1 + instance_.vertex(vertex_id_2).weight <= weight)
+                break;
+            if (marks_[vertex_id_2] == mark_)
+                continue;
+            remove(vertex_id);
+            add(vertex_id_1);
+            add(vertex_id_2);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Counter SwapLocalSearch::local_search(
+        std::mt19937_64& generator,
+        VertexId tabu_vertex_id)
+{
+    // Variable neighborhood descent: (1,2)-swaps are only tried when no
+    // (ω,1)-swap is improving.
+    Counter number_of_moves = 0;
+    for (;;) {
+        if (!improving_vertices_.empty()) {
+            std::uniform_int_distribution<VertexPos> distribution(0, improving_vertices_.size() - 1);
+            VertexId vertex_id = *(improving_vertices_.begin() + distribution(generator));
+            if (tabu_vertex_id != -1
+                    && tightnesses_[vertex_id] > 0
+                    && instance_.has_edge(vertex_id, tabu_vertex_id)) {
+                improving_vertices_.remove(vertex_id);
+                tabu_vertices_.push_back(vertex_id);
+                continue;
+            }
+            force(vertex_id);
+            number_of_moves++;
+        } else if (!candidates_.empty()) {
+            std::uniform_int_distribution<VertexPos> distribution(0, candidates_.size() - 1);
+            VertexId vertex_id = *(candidates_.begin() + distribution(generator));
+            candidates_.remove(vertex_id);
+            assert(in_[vertex_id]);
+            if (vertex_id != tabu_vertex_id && swap(vertex_id))
+                number_of_moves++;
+        } else {
+            break;
+        }
+    }
+    for (VertexId vertex_id: tabu_vertices_)
+        update_improving_vertices(vertex_id);
+    tabu_vertices_.clear();
+    return number_of_moves;
+}
+
+}
+
+const IteratedLocalSearchOutput stablesolver::stable::iterated_local_search(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const IteratedLocalSearchParameters& parameters)
+{
+    IteratedLocalSearchOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Iterated local search");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce) {
+        return solve_reduced_instance(
+                [&generator](
+                    const Instance& instance,
+                    const Parameters& parameters)
+                {
+                    return iterated_local_search(
+                            instance,
+                            generator,
+                            static_cast<const IteratedLocalSearchParameters&>(parameters));
+                },
+                instance,
+                parameters,
+                algorithm_formatter,
+                output);
+    }
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose) {
+        // The components may be solved concurrently, so each of them gets
+        // its own generator.
+        std::mutex generator_mutex;
+        return solve_components(
+                [&generator, &generator_mutex](
+                    const Instance& instance,
+                    const Parameters& parameters)
+                {
+                    std::mt19937_64 component_generator;
+                    {
+                        std::lock_guard<std::mutex> lock(generator_mutex);
+                        component_generator.seed(generator());
+                    }
+                    return iterated_local_search(
+                            instance,
+                            component_generator,
+                            static_cast<const IteratedLocalSearchParameters&>(parameters));
+                },
+                instance,
+                parameters,
+                algorithm_formatter,
+                output);
+    }
+
+    algorithm_formatter.print_header();
+
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    if (instance.number_of_vertices() == 0) {
+        algorithm_formatter.end();
+        return output;
+    }
+
+    // Compute initial greedy solution.
+    GreedyParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    greedy_parameters.timer = parameters.timer;
+    greedy_parameters.reduction_parameters.reduce = false;
+    greedy_parameters.clique_cover_parameters.enable = false;
+    Solution solution = greedy_gwmin(instance, greedy_parameters).solution;
+    algorithm_formatter.update_solution(solution, "initial solution");
+
+    SwapLocalSearch local_search(instance);
+    local_search.start_recording();
+    for (VertexId vertex_id: solution.vertices())
+        local_search.force(vertex_id);
+    output.number_of_moves += local_search.local_search(generator, -1);
+
+    // The best solution is updated from the vertices modified since it was
+    // saved, so that saving it doesn't depend on the size of the instance.
+    // It is only converted when it is reported.
+    std::vector<int8_t> solution_best(instance.number_of_vertices(), 0);
+    for (VertexId vertex_id: local_search.log()) {
+        if (vertex_id >= 0) {
+            solution_best[vertex_id] = 1;
+        } else {
+            solution_best[~vertex_id] = 0;
+        }
+    }
+    Weight weight_best = local_search.weight();
+    optimizationtools::IndexedSet modified_vertices(instance.number_of_vertices());
+    bool solution_best_reported = false;
+    double last_report_time = parameters.timer.elapsed_time();
+    auto report = [&instance, &algorithm_formatter, &solution_best, &solution_best_reported](
+            const std::string& s)
+    {
+        Solution solution(instance);
+        for (VertexId vertex_id = 0;
+                vertex_id < instance.number_of_vertices();
+                ++vertex_id) {
+            if (solution_best[vertex_id])
+                solution.add(vertex_id);
+        }
+        algorithm_formatter.update_solution(solution, s);
+        solution_best_reported = true;
+    };
+    report("initial local search");
+
+    std::uniform_int_distribution<VertexId> distribution(0, instance.number_of_vertices() - 1);
+    Counter number_of_iterations_without_improvement = 0;
+    for (output.number_of_iterations = 0;
+            !parameters.timer.needs_to_end();
+            ++output.number_of_iterations,
+            ++number_of_iterations_without_improvement) {
+
+        // Check stop criteria.
+        if (parameters.maximum_number_of_iterations != -1
+                && output.number_of_iterations >= parameters.maximum_number_of_iterations)
+            break;
+        if (parameters.maximum_number_of_iterations_without_improvement != -1
+                && number_of_iterations_without_improvement
+                >= parameters.maximum_number_of_iterations_without_improvement)
+            break;
+        // Stop if the best solution is optimal.
+        if (weight_best == output.bound)
+            break;
+
+        // Perturbation: force a random vertex into the solution.
+        VertexId vertex_id = distribution(generator);
+        if (local_search.contains(vertex_id))
+            continue;
+        Weight weight = local_search.weight();
+        local_search.start_recording();
+        local_search.force(vertex_id);
+        output.number_of_moves += local_search.local_search(generator, vertex_id);
+
+        // Acceptance.
+        if (local_search.weight() < weight) {
+            local_search.undo();
+            continue;
+        }
+        for (VertexId vertex_id: local_search.log())
+            modified_vertices.add((vertex_id >= 0)? vertex_id: ~vertex_id);
+        if (local_search.weight() > weight_best) {
+            for (VertexId vertex_id: modified_vertices)
+                solution_best[vertex_id] = local_search.contains(vertex_id);
+            modified_vertices.clear();
+            weight_best = local_search.weight();
+            solution_best_reported = false;
+            number_of_iterations_without_improvement = 0;
+        }
+
+        // Report the best solution at most every 0.1 second, since
+        // converting it is linear in the size of the instance.
+        if (!solution_best_reported
+                && parameters.timer.elapsed_time() - last_report_time > 0.1) {
+            std::stringstream ss;
+            ss << "iteration " << output.number_of_iterations;
+            report(ss.str());
+            last_report_time = parameters.timer.elapsed_time();
+        }
+    }
+
+    if (!solution_best_reported) {
+        std::stringstream ss;
+        ss << "iteration " << output.number_of_iterations;
+        report(ss.str());
+    }
+
+    algorithm_formatter.end();
+    return output;
+}
@@ -0,0 +1,249 @@
+#include "stablesolver/stable/algorithms/lagrangian_relaxation.hpp"
+
+#include "stablesolver/stable/algorithm_formatter.hpp"
+#include "stablesolver/stable/algorithms/greedy.hpp"
+
+#include <cmath>
+#include <numeric>
+
+using namespace stablesolver::stable;
+
+namespace
+{
+
+/**
+ * Compute a solution from the reduced weights of the vertices by adding them
+ * greedily by non-increasing reduced weight.
+ */
+Solution lagrangian_heuristic(
+        const Instance& instance,
+        const std::vector<double>& reduced_weights)
+{
+    std::vector<VertexId> sorted_vertices(instance.number_of_vertices());
+    std::iota(sorted_vertices.begin(), sorted_vertices.end(), 0);
+    std::sort(
+            sorted_vertices.begin(),
+            sorted_vertices.end(),
+            [&reduced_weights](VertexId vertex_id_1, VertexId vertex_id_2) -> bool
+            {
+                return reduced_weights[vertex_id_1] > reduced_weights[vertex_id_2];
+            });
+
+    Solution solution(instance);
+    std::vector<int8_t> available_vertices(instance.number_of_vertices(), 1);
+    for (VertexId vertex_id: sorted_vertices) {
+        if (!available_vertices[vertex_id])
+            continue;
+        solution.add(vertex_id);
+        for (const auto& edge: instance.vertex(vertex_id).edges)
+            available_vertices[edge.vertex_id] = 0;
+    }
+    return solution;
+}
+
+}
+
+const LagrangianRelaxationOutput stablesolver::stable::lagrangian_relaxation(
+        const Instance& instance,
+        const LagrangianRelaxationParameters& parameters)
+{
+    LagrangianRelaxationOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Lagrangian relaxation");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce)
+        return solve_reduced_instance(lagrangian_relaxation, instance, parameters, algorithm_formatter, output);
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(lagrangian_relaxation, instance, parameters, algorithm_formatter, output);
+
+    algorithm_formatter.print_header();
+
+    // Compute initial greedy solution.
+    GreedyParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    greedy_parameters.timer = parameters.timer;
+    greedy_parameters.reduction_parameters.reduce = false;
+    greedy_parameters.clique_cover_parameters.enable = false;
+    Solution solution = greedy_gwmin(instance, greedy_parameters).solution;
+    algorithm_formatter.update_solution(solution, "initial solution");
+
+    VertexId number_of_vertices = instance.number_of_vertices();
+    if (number_of_vertices == 0) {
+        algorithm_formatter.end();
+        return output;
+    }
+
+    // Relaxed clique constraints. The multiplier of a clique is initialized
+    // to its maximum weight, so that the initial bound is the clique cover
+    // bound.
+    std::vector<VertexPos> vertices_cliques(number_of_vertices, -1);
+    std::vector<double> cliques_multipliers;
+    if (parameters.clique_constraints) {
+        CliqueCoverParameters clique_cover_parameters = parameters.clique_cover_parameters;
+        clique_cover_parameters.enable = true;
+        CliqueCover clique_cover(instance, clique_cover_parameters);
+        for (const std::vector<VertexId>& clique: clique_cover.cliques()) {
+            if (clique.size() == 1)
+                continue;
+            Weight weight = 0;
+            for (VertexId vertex_id: clique) {
+                vertices_cliques[vertex_id] = cliques_multipliers.size();
+                weight = (std::max)(weight, instance.vertex(vertex_id).weight);
+            }
+            cliques_multipliers.push_back(weight);
+        }
+    }
+    VertexPos number_of_cliques = cliques_multipliers.size();
+
+    // Relaxed edge constraints, for the edges which are not inside a clique.
+    // In flat arrays, so that the sweeps over the edges vectorize.
+    std::vector<VertexId> edges_vertices_1;
+    std::vector<VertexId> edges_vertices_2;
+    std::vector<double> edges_multipliers;
+    for (EdgeId edge_id = 0; edge_id < instance.number_of_edges(); ++edge_id) {
+        VertexId vertex_id_1 = instance.edge(edge_id).vertex_id_1;
+        VertexId vertex_id_2 = instance.edge(edge_id).vertex_id_2;
+        if (vertices_cliques[vertex_id_1] != -1
+                && vertices_cliques[vertex_id_1] == vertices_cliques[vertex_id_2]) {
+            continue;
+        }
+        edges_vertices_1.push_back(vertex_id_1);
+        edges_vertices_2.push_back(vertex_id_2);
+        // Without clique constraints, share the weight of each vertex among
+        // its edges, so that the initial reduced weights are non-negative.
+        double multiplier = (parameters.clique_constraints)? 0.0: (std::min)(
+                (double)instance.vertex(vertex_id_1).weight / instance.degree(vertex_id_1),
+                (double)instance.vertex(vertex_id_2).weight / instance.degree(vertex_id_2));
+        edges_multipliers.push_back(multiplier);
+    }
+    EdgeId number_of_relaxed_edges = edges_multipliers.size();
+
+    std::vector<double> weights(number_of_vertices);
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        weights[vertex_id] = instance.vertex(vertex_id).weight;
+    std::vector<double> reduced_weights(number_of_vertices);
+    std::vector<double> vertices_x(number_of_vertices);
+    std::vector<double> cliques_subgradients(number_of_cliques);
+    std::vector<double> edges_subgradients(number_of_relaxed_edges);
+
+    double step_size_coefficient = parameters.initial_step_size_coefficient;
+    double lagrangian_bound_best = std::numeric_limits<double>::infinity();
+    Counter number_of_iterations_without_improvement = 0;
+    for (output.number_of_iterations = 0;
+            !parameters.timer.needs_to_end();
+            ++output.number_of_iterations) {
+        // Check stop criteria.
+        if (parameters.maximum_number_of_iterations != -1
+                && output.number_of_iterations >= parameters.maximum_number_of_iterations)
+            break;
+        if (step_size_coefficient < parameters.minimum_step_size_coefficient)
+            break;
+        if (output.solution.weight() >= output.bound)
+            break;
+
+        // Compute the reduced weights.
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+            VertexPos clique_id = vertices_cliques[vertex_id];
+            reduced_weights[vertex_id] = weights[vertex_id]
+                - ((clique_id != -1)? cliques_multipliers[clique_id]: 0.0);
+        }
+        for (EdgeId edge_pos = 0; edge_pos < number_of_relaxed_edges; ++edge_pos) {
+            reduced_weights[edges_vertices_1[edge_pos]] -= edges_multipliers[edge_pos];
+            reduced_weights[edges_vertices_2[edge_pos]] -= edges_multipliers[edge_pos];
+        }
+
+        // Solve the relaxed problem. The sum of the absolute values of the
+        // terms bounds the rounding error of the bound.
+        double lagrangian_bound = 0.0;
+        double lagrangian_bound_magnitude = 0.0;
+        for (VertexPos clique_id = 0; clique_id < number_of_cliques; ++clique_id) {
+            lagrangian_bound += cliques_multipliers[clique_id];
+            lagrangian_bound_magnitude += std::abs(cliques_multipliers[clique_id]);
+        }
+        for (EdgeId edge_pos = 0; edge_pos < number_of_relaxed_edges; ++edge_pos) {
+            lagrangian_bound += edges_multipliers[edge_pos];
+            lagrangian_bound_magnitude += std::abs(edges_multipliers[edge_pos]);
+        }
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+            vertices_x[vertex_id] = (reduced_weights[vertex_id] > 0)? 1.0: 0.0;
+            lagrangian_bound += vertices_x[vertex_id] * reduced_weights[vertex_id];
+            lagrangian_bound_magnitude += vertices_x[vertex_id] * reduced_weights[vertex_id];
+        }
+
+        // Update bound.
+        if (lagrangian_bound < lagrangian_bound_best - FFOT_TOL) {
+            lagrangian_bound_best = lagrangian_bound;
+            number_of_iterations_without_improvement = 0;
+            std::stringstream ss;
+            ss << "iteration " << output.number_of_iterations;
+            // Round conservatively: an absolute tolerance isn't enough on
+            // instances with large weights.
+            double tolerance = (std::max)(1e-5, 1e-9 * lagrangian_bound_magnitude);
+            algorithm_formatter.update_bound(std::floor(lagrangian_bound + tolerance), ss.str());
+        } else {
+            number_of_iterations_without_improvement++;
+            if (number_of_iterations_without_improvement
+                    >= parameters.number_of_iterations_before_step_size_update) {
+                step_size_coefficient /= 2;
+                number_of_iterations_without_improvement = 0;
+            }
+        }
+
+        // Lagrangian heuristic.
+        if (output.number_of_iterations % 10 == 0) {
+            std::stringstream ss;
+            ss << "iteration " << output.number_of_iterations;
+            algorithm_formatter.update_solution(
+                    lagrangian_heuristic(instance, reduced_weights),
+                    ss.str());
+        }
+
+        // Compute the subgradients. Components which would make a multiplier
+        // negative are projected out.
+        std::fill(cliques_subgradients.begin(), cliques_subgradients.end(), 1.0);
+        for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+            VertexPos clique_id = vertices_cliques[vertex_id];
+            if (clique_id != -1)
+                cliques_subgradients[clique_id] -= vertices_x[vertex_id];
+        }
+        double norm = 0.0;
+        for (VertexPos clique_id = 0; clique_id < number_of_cliques; ++clique_id) {
+            if (cliques_multipliers[clique_id] == 0.0 && cliques_subgradients[clique_id] > 0)
+                cliques_subgradients[clique_id] = 0.0;
+            norm += cliques_subgradients[clique_id] * cliques_subgradients[clique_id];
+        }
+        for (EdgeId edge_pos = 0; edge_pos < number_of_relaxed_edges; ++edge_pos) {
+            double subgradient = 1.0
+                - vertices_x[edges_vertices_1[edge_pos]]
+                - vertices_x[edges_vertices_2[edge_pos]];
+            if (edges_multipliers[edge_pos] == 0.0 && subgradient > 0)
+                subgradient = 0.0;
+            edges_subgradients[edge_pos] = subgradient;
+            norm += subgradient * subgradient;
+        }
+        // The solution of the relaxed problem is feasible and satisfies the
+        // complementary slackness conditions: the bound is optimal.
+        if (norm == 0.0)
+            break;
+
+        // Update the multipliers.
+        double step_size = step_size_coefficient
+            * (lagrangian_bound - output.solution.weight()) / norm;
+        for (VertexPos clique_id = 0; clique_id < number_of_cliques; ++clique_id) {
+            cliques_multipliers[clique_id] = (std::max)(0.0,
+                    cliques_multipliers[clique_id]
+                    - step_size * cliques_subgradients[clique_id]);
+        }
+        for (EdgeId edge_pos = 0; edge_pos < number_of_relaxed_edges; ++edge_pos) {
+            edges_multipliers[edge_pos] = (std::max)(0.0,
+                    edges_multipliers[edge_pos]
+                    - step_size * edges_subgradients[edge_pos]);
+        }
+    }
+
+    algorithm_formatter.end();
+    return output;
+}
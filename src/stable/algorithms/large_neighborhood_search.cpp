@@ -2,10 +2,16 @@
 
 #include "stablesolver/stable/algorithm_formatter.hpp"
 #include "stablesolver/stable/algorithms/greedy.hpp"
+#include "stablesolver/stable/algorithms/lagrangian_relaxation.hpp"
 
 #include "optimizationtools/containers/indexed_set.hpp"
 #include "optimizationtools/containers/indexed_binary_heap.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 using namespace stablesolver::stable;
 
 struct LargeNeighborhoodSearchVertex
@@ -17,98 +23,407 @@ struct LargeNeighborhoodSearchVertex
     Weight  score         = 0;
 };
 
-const LargeNeighborhoodSearchOutput stablesolver::stable::large_neighborhood_search(
-        const Instance& instance,
-        const LargeNeighborhoodSearchParameters& parameters)
+namespace
 {
-    LargeNeighborhoodSearchOutput output(instance);
-    AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Large neighborhood search");
 
-    // Reduction.
-    if (parameters.reduction_parameters.reduce)
-        return solve_reduced_instance(large_neighborhood_search, instance, parameters, algorithm_formatter, output);
+/**
+ * Structure for the data shared by the walkers.
+ */
+struct LargeNeighborhoodSearchShared
+{
+    /** Weight of the best solution. */
+    std::atomic<Weight> best_weight{-1};
 
-    algorithm_formatter.print_header();
+    /** Bound. */
+    std::atomic<Weight> bound{-1};
 
-    Solution solution = greedy_gwmin(instance).solution;
-    algorithm_formatter.update_solution(solution, "initial solution");
+    /** Total number of iterations reported by the walkers. */
+    std::atomic<Counter> number_of_iterations{0};
+
+    /** Mutex protecting the algorithm formatter and the output. */
+    std::mutex mutex;
+};
+
+/**
+ * Destroy operators, in the order of
+ * 'LargeNeighborhoodSearchOutput::destroy_operators'.
+ */
+enum class LargeNeighborhoodSearchDestroyOperator
+{
+    Score,
+    Random,
+    Component,
+    Ball,
+};
+
+/**
+ * Factors of the destroy sizes, in the order of
+ * 'LargeNeighborhoodSearchOutput::destroy_sizes'.
+ */
+const double destroy_size_factors[] = {0.25, 0.5, 1, 2, 4};
+
+/**
+ * Structure for the adaptive weight of a destroy operator or of a destroy
+ * size.
+ */
+struct LargeNeighborhoodSearchArm
+{
+    /** Weight. */
+    double weight = 0;
+
+    /** Gain during the current segment. */
+    Weight segment_gain = 0;
+
+    /** Time spent during the current segment, in seconds. */
+    double segment_time = 0;
+
+    /** Number of iterations during the current segment. */
+    Counter segment_number_of_iterations = 0;
+};
+
+/**
+ * Draw an arm with a probability proportional to its weight.
+ *
+ * Each arm gets at least a tenth of the largest weight, so that the arms
+ * which performed poorly so far are still tried from time to time.
+ */
+Counter draw(
+        const std::vector<LargeNeighborhoodSearchArm>& arms,
+        std::mt19937_64& generator)
+{
+    double weight_max = 0;
+    for (const LargeNeighborhoodSearchArm& arm: arms)
+        weight_max = (std::max)(weight_max, arm.weight);
+    auto weight = [weight_max](const LargeNeighborhoodSearchArm& arm)
+    {
+        return (weight_max > 0)? (std::max)(arm.weight, 0.1 * weight_max): 1.0;
+    };
+    double total_weight = 0;
+    for (const LargeNeighborhoodSearchArm& arm: arms)
+        total_weight += weight(arm);
+    std::uniform_real_distribution<double> d(0, total_weight);
+    double r = d(generator);
+    for (Counter arm_id = 0; arm_id < (Counter)arms.size(); ++arm_id) {
+        r -= weight(arms[arm_id]);
+        if (r < 0)
+            return arm_id;
+    }
+    return arms.size() - 1;
+}
+
+/**
+ * Update the weights of the arms used during the segment with their gain
+ * per millisecond, or per iteration if 'deterministic' is true, and start a
+ * new segment.
+ */
+void update_weights(
+        std::vector<LargeNeighborhoodSearchArm>& arms,
+        double reaction_factor,
+        bool deterministic)
+{
+    for (LargeNeighborhoodSearchArm& arm: arms) {
+        if (deterministic && arm.segment_number_of_iterations > 0) {
+            double gain_per_iteration = (double)arm.segment_gain / arm.segment_number_of_iterations;
+            arm.weight = (1 - reaction_factor) * arm.weight
+                + reaction_factor * gain_per_iteration;
+        } else if (!deterministic && arm.segment_time > 0) {
+            double gain_per_millisecond = arm.segment_gain / (1000 * arm.segment_time);
+            arm.weight = (1 - reaction_factor) * arm.weight
+                + reaction_factor * gain_per_millisecond;
+        }
+        arm.segment_gain = 0;
+        arm.segment_time = 0;
+        arm.segment_number_of_iterations = 0;
+    }
+}
+
+/**
+ * Add the result of an iteration to an arm and to its statistics.
+ */
+void update_statistics(
+        LargeNeighborhoodSearchArm& arm,
+        LargeNeighborhoodSearchStatistics& statistics,
+        Weight gain,
+        double time,
+        bool improvement)
+{
+    arm.segment_gain += gain;
+    arm.segment_time += time;
+    arm.segment_number_of_iterations++;
+    statistics.number_of_calls++;
+    if (improvement)
+        statistics.number_of_improvements++;
+    statistics.gain += gain;
+    statistics.time += time;
+}
+
+/**
+ * Add the statistics gathered by a walker since its last report to the
+ * statistics of the output.
+ */
+void report_statistics(
+        const std::vector<LargeNeighborhoodSearchStatistics>& statistics,
+        std::vector<LargeNeighborhoodSearchStatistics>& statistics_reported,
+        std::vector<LargeNeighborhoodSearchStatistics>& output_statistics)
+{
+    for (std::size_t pos = 0; pos < statistics.size(); ++pos) {
+        output_statistics[pos].number_of_calls += statistics[pos].number_of_calls - statistics_reported[pos].number_of_calls;
+        output_statistics[pos].number_of_improvements += statistics[pos].number_of_improvements - statistics_reported[pos].number_of_improvements;
+        output_statistics[pos].gain += statistics[pos].gain - statistics_reported[pos].gain;
+        output_statistics[pos].time += statistics[pos].time - statistics_reported[pos].time;
+    }
+    statistics_reported = statistics;
+}
+
+/**
+ * Run a walker of the large neighborhood search.
+ *
+ * Only the first walker refines the clique cover bound and reports the
+ * Lagrangian relaxation bound.
+ */
+void large_neighborhood_search_walker(
+        const Instance& instance,
+        const LargeNeighborhoodSearchParameters& parameters,
+        CliqueCover* clique_cover,
+        const std::atomic<Weight>* lagrangian_bound,
+        const Solution& initial_solution,
+        LargeNeighborhoodSearchShared& shared,
+        AlgorithmFormatter& algorithm_formatter,
+        LargeNeighborhoodSearchOutput& output,
+        Counter walker_id,
+        Seed seed)
+{
+    std::mt19937_64 generator(seed);
+    std::mt19937_64 clique_cover_generator;
+    Solution solution(initial_solution);
+    Weight best_weight = solution.weight();
 
     // Initialize local search structures.
     std::vector<LargeNeighborhoodSearchVertex> vertices(instance.number_of_vertices());
     std::vector<Penalty> solution_penalties(instance.number_of_edges(), 1);
-    for (auto it_v = solution.vertices().out_begin();
-            it_v != solution.vertices().out_end();
-            ++it_v) {
-        VertexId vertex_id = *it_v;
-        for (const auto& edge: instance.vertex(vertex_id).edges)
-            if (solution.contains(edge.vertex_id))
-                vertices[vertex_id].score += solution_penalties[edge.edge_id];
-    }
     optimizationtools::IndexedBinaryHeap<std::pair<double, Counter>> scores_out(instance.number_of_vertices());
     optimizationtools::IndexedBinaryHeap<std::pair<double, Counter>> scores_in(instance.number_of_vertices());
-    for (auto it_v = solution.vertices().out_begin();
-            it_v != solution.vertices().out_end();
-            ++it_v) {
-        VertexId vertex_id = *it_v;
-        scores_out.update_key(
-                vertex_id,
-                {(double)vertices[vertex_id].score / instance.vertex(vertex_id).weight, 0});
-    }
+    // Compute the scores of a feasible solution and fill the heaps. The
+    // penalties and the timestamps are kept.
+    auto initialize = [&instance, &solution, &vertices, &solution_penalties, &scores_out, &scores_in]()
+    {
+        scores_out = optimizationtools::IndexedBinaryHeap<std::pair<double, Counter>>(instance.number_of_vertices());
+        while (!scores_in.empty())
+            scores_in.pop();
+        for (VertexId vertex_id = 0;
+                vertex_id < instance.number_of_vertices();
+                ++vertex_id) {
+            vertices[vertex_id].score = 0;
+        }
+        for (auto it_v = solution.vertices().out_begin();
+                it_v != solution.vertices().out_end();
+                ++it_v) {
+            VertexId vertex_id = *it_v;
+            for (const auto& edge: instance.vertex(vertex_id).edges)
+                if (solution.contains(edge.vertex_id))
+                    vertices[vertex_id].score += solution_penalties[edge.edge_id];
+            scores_out.update_key(
+                    vertex_id,
+                    {(double)vertices[vertex_id].score / instance.vertex(vertex_id).weight, 0});
+        }
+    };
+    initialize();
 
     optimizationtools::IndexedSet sets_in_to_update(instance.number_of_vertices());
     optimizationtools::IndexedSet sets_out_to_update(instance.number_of_vertices());
+
+    // Adaptive weights and statistics of the destroy operators and sizes.
+    std::vector<LargeNeighborhoodSearchArm> destroy_operator_arms(output.destroy_operators.size());
+    std::vector<LargeNeighborhoodSearchArm> destroy_size_arms(output.destroy_sizes.size());
+    std::vector<LargeNeighborhoodSearchStatistics> destroy_operators(destroy_operator_arms.size());
+    std::vector<LargeNeighborhoodSearchStatistics> destroy_sizes(destroy_size_arms.size());
+    std::vector<LargeNeighborhoodSearchStatistics> destroy_operators_reported(destroy_operators);
+    std::vector<LargeNeighborhoodSearchStatistics> destroy_sizes_reported(destroy_sizes);
+    // Vertices reached by the breadth-first search of the ball operator.
+    optimizationtools::IndexedSet ball(instance.number_of_vertices());
+    std::vector<VertexId> ball_queue;
+
+    Counter number_of_iterations = 0;
+    // Add a vertex to the solution.
+    auto add = [&instance, &solution, &vertices, &solution_penalties, &scores_out, &sets_in_to_update, &sets_out_to_update, &number_of_iterations](
+            VertexId vertex_id)
+    {
+        scores_out.update_key(vertex_id, {-1, -1});
+        scores_out.pop();
+        solution.add(vertex_id);
+        //std::cout << "add " << v
+            //<< " p.second " << p.second.first
+            //<< " score " << vertices[v].score
+            //<< " weight " << instance.vertex(v).weight
+            //<< " p " << solution.penalty()
+            //<< " p_tmp " << p_tmp
+            //<< std::endl;
+        vertices[vertex_id].last_addition = number_of_iterations;
+        sets_in_to_update.add(vertex_id);
+        // Update scores.
+        sets_out_to_update.clear();
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (solution.contains(edge.vertex_id)) {
+                vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
+                sets_in_to_update.add(edge.vertex_id);
+            } else {
+                vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
+                sets_out_to_update.add(edge.vertex_id);
+            }
+        }
+        for (VertexId vertex_id_2: sets_out_to_update)
+            scores_out.update_key(vertex_id_2, {(double)vertices[vertex_id_2].score / instance.vertex(vertex_id_2).weight, vertices[vertex_id_2].last_removal});
+    };
+    // Draw a random vertex outside of the solution.
+    auto random_vertex = [&instance, &solution, &generator]()
+    {
+        std::uniform_int_distribution<VertexId> d_v(
+                0, instance.number_of_vertices() - solution.number_of_vertices() - 1);
+        return *(solution.vertices().out_begin() + d_v(generator));
+    };
+    // The iterations are grouped in blocks using the same destroy operator
+    // and the same destroy size. The gain of a block is the increase of the
+    // weight of the current solution between the start of the block and its
+    // best iteration, so that an operator which degrades the solution before
+    // leading to a better one is rewarded.
+    Counter destroy_operator_id = 0;
+    Counter destroy_size_id = 0;
+    Weight block_start_weight = 0;
+    Weight block_best_weight = 0;
+    // Number of iterations already added to the shared number of iterations.
+    Counter number_of_iterations_reported = 0;
     Counter iterations_without_improvment = 0;
-    for (output.iterations = 1;
+    for (number_of_iterations = 1;
             !parameters.timer.needs_to_end();
-            ++output.iterations, ++iterations_without_improvment) {
+            ++number_of_iterations, ++iterations_without_improvment) {
 
         // Check stop criteria.
         if (parameters.maximum_number_of_iterations != -1
-                && output.iterations > parameters.maximum_number_of_iterations)
+                && number_of_iterations > parameters.maximum_number_of_iterations)
             break;
         if (parameters.maximum_number_of_iterations_without_improvement != -1
                 && iterations_without_improvment > parameters.maximum_number_of_iterations_without_improvement)
             break;
+
+        // Refine the clique cover bound, using at most 5% of the time.
+        if (clique_cover != nullptr
+                && number_of_iterations % 1024 == 0
+                && clique_cover->time() < 0.05 * parameters.timer.elapsed_time()
+                && clique_cover->improve(clique_cover_generator)) {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            algorithm_formatter.update_bound(clique_cover->bound(), "clique cover");
+            shared.bound = output.bound;
+        }
+        if (lagrangian_bound != nullptr
+                && *lagrangian_bound < shared.bound) {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            algorithm_formatter.update_bound(*lagrangian_bound, "lagrangian relaxation");
+            shared.bound = output.bound;
+        }
+        // Stop if the best solution is optimal.
+        if (shared.best_weight == shared.bound)
+            break;
+
+        // Restart from the best solution of the walkers if the walker lags
+        // behind.
+        if (parameters.restart_interval > 0
+                && number_of_iterations % parameters.restart_interval == 0
+                && shared.best_weight > best_weight) {
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                solution = output.solution;
+            }
+            best_weight = solution.weight();
+            initialize();
+            block_start_weight = solution.weight();
+            block_best_weight = solution.weight();
+        }
+
         //std::cout
             //<< "weight " << solution.weight()
             //<< " v " << solution.number_of_vertices()
             //<< " f " << solution.feasible()
             //<< std::endl;
 
-        // Add vertices.
-        VertexPos number_of_removed_vertices = sqrt(instance.number_of_vertices() - solution.number_of_vertices());
+        auto iteration_start = std::chrono::steady_clock::now();
+
+        // Draw the destroy operator and the destroy size of the block.
+        if ((number_of_iterations - 1) % parameters.adaptive_block_length == 0) {
+            destroy_operator_id = draw(destroy_operator_arms, generator);
+            destroy_size_id = draw(destroy_size_arms, generator);
+            block_start_weight = solution.weight();
+            block_best_weight = solution.weight();
+        }
+        VertexPos number_of_removed_vertices = destroy_size_factors[destroy_size_id]
+            * sqrt(instance.number_of_vertices() - solution.number_of_vertices());
+        number_of_removed_vertices = (std::min)(
+                (std::max)((VertexPos)1, number_of_removed_vertices),
+                instance.number_of_vertices() - solution.number_of_vertices());
         //std::cout << "number_of_removed_vertices " << removed_number_of_vertices << std::endl;
+
+        // Add vertices.
         sets_in_to_update.clear();
-        for (VertexPos s_tmp = 0;
-                s_tmp < number_of_removed_vertices && !scores_out.empty();
-                ++s_tmp) {
-            auto p = scores_out.top();
-            scores_out.pop();
-            VertexId vertex_id = p.first;
-            solution.add(vertex_id);
-            //std::cout << "add " << v
-                //<< " p.second " << p.second.first
-                //<< " score " << vertices[v].score
-                //<< " weight " << instance.vertex(v).weight
-                //<< " p " << solution.penalty()
-                //<< " p_tmp " << p_tmp
-                //<< std::endl;
-            vertices[vertex_id].last_addition = output.iterations;
-            sets_in_to_update.add(vertex_id);
-            // Update scores.
-            sets_out_to_update.clear();
-            for (const auto& edge: instance.vertex(vertex_id).edges) {
-                if (solution.contains(edge.vertex_id)) {
-                    vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
-                    sets_in_to_update.add(edge.vertex_id);
-                } else {
-                    vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
-                    sets_out_to_update.add(edge.vertex_id);
+        VertexPos number_of_added_vertices = 0;
+        switch ((LargeNeighborhoodSearchDestroyOperator)destroy_operator_id) {
+        case LargeNeighborhoodSearchDestroyOperator::Score: {
+            for (; number_of_added_vertices < number_of_removed_vertices;
+                    ++number_of_added_vertices) {
+                add(scores_out.top().first);
+            }
+            break;
+        } case LargeNeighborhoodSearchDestroyOperator::Random: {
+            for (; number_of_added_vertices < number_of_removed_vertices;
+                    ++number_of_added_vertices) {
+                add(random_vertex());
+            }
+            break;
+        } case LargeNeighborhoodSearchDestroyOperator::Component: {
+            if (number_of_removed_vertices == 0)
+                break;
+            VertexId vertex_id_seed = random_vertex();
+            const Component& component = instance.component(instance.vertex(vertex_id_seed).component);
+            add(vertex_id_seed);
+            number_of_added_vertices++;
+            // The number of draws is bounded since the component may not
+            // have enough vertices outside of the solution.
+            std::uniform_int_distribution<VertexPos> d_p(0, component.vertices.size() - 1);
+            for (VertexPos number_of_draws = 0;
+                    number_of_added_vertices < number_of_removed_vertices
+                    && number_of_draws < 4 * number_of_removed_vertices;
+                    ++number_of_draws) {
+                VertexId vertex_id = component.vertices[d_p(generator)];
+                if (!solution.contains(vertex_id)) {
+                    add(vertex_id);
+                    number_of_added_vertices++;
+                }
+            }
+            break;
+        } case LargeNeighborhoodSearchDestroyOperator::Ball: {
+            if (number_of_removed_vertices == 0)
+                break;
+            VertexId vertex_id_seed = random_vertex();
+            ball.clear();
+            ball_queue.clear();
+            ball.add(vertex_id_seed);
+            ball_queue.push_back(vertex_id_seed);
+            for (VertexPos queue_pos = 0;
+                    queue_pos < (VertexPos)ball_queue.size()
+                    && number_of_added_vertices < number_of_removed_vertices;
+                    ++queue_pos) {
+                VertexId vertex_id = ball_queue[queue_pos];
+                if (!solution.contains(vertex_id)) {
+                    add(vertex_id);
+                    number_of_added_vertices++;
+                }
+                for (const auto& edge: instance.vertex(vertex_id).edges) {
+                    if (!ball.contains(edge.vertex_id)) {
+                        ball.add(edge.vertex_id);
+                        ball_queue.push_back(edge.vertex_id);
+                    }
                 }
             }
-            for (VertexId vertex_id_2: sets_out_to_update)
-                scores_out.update_key(vertex_id_2, {(double)vertices[vertex_id_2].score / instance.vertex(vertex_id_2).weight, vertices[vertex_id_2].last_removal});
+            break;
+        }
         }
         for (VertexId vertex_id_2: sets_in_to_update)
             scores_in.update_key(vertex_id_2, {- (double)vertices[vertex_id_2].score / instance.vertex(vertex_id_2).weight, vertices[vertex_id_2].last_removal});
@@ -146,7 +461,7 @@ const LargeNeighborhoodSearchOutput stablesolver::stable::large_neighborhood_sea
                 //<< " p_tmp " << p_tmp
                 //<< std::endl;
             assert(p.second.first < 0);
-            vertices[vertex_id].last_removal = output.iterations;
+            vertices[vertex_id].last_removal = number_of_iterations;
             sets_out_to_update.add(vertex_id);
             // Update scores.
             sets_in_to_update.clear();
@@ -170,7 +485,7 @@ const LargeNeighborhoodSearchOutput stablesolver::stable::large_neighborhood_sea
                         //<< " weight " << instance.vertex(edge.v).weight
                         //<< " p " << solution.penalty()
                         //<< std::endl;
-                    vertices[edge.vertex_id].last_addition = output.iterations;
+                    vertices[edge.vertex_id].last_addition = number_of_iterations;
                     sets_in_to_update.add(edge.vertex_id);
                     for (const auto& edge_2: instance.vertex(edge.vertex_id).edges) {
                         assert(!solution.contains(edge_2.vertex_id));
@@ -198,17 +513,179 @@ const LargeNeighborhoodSearchOutput stablesolver::stable::large_neighborhood_sea
             }
         }
 
+        // Update the weights and the statistics.
+        double iteration_time = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - iteration_start).count();
+        block_best_weight = (std::max)(block_best_weight, solution.weight());
+        Weight gain = (number_of_iterations % parameters.adaptive_block_length == 0)?
+            block_best_weight - block_start_weight: 0;
+        bool improvement = (best_weight < solution.weight());
+        update_statistics(
+                destroy_operator_arms[destroy_operator_id],
+                destroy_operators[destroy_operator_id],
+                gain,
+                iteration_time,
+                improvement);
+        update_statistics(
+                destroy_size_arms[destroy_size_id],
+                destroy_sizes[destroy_size_id],
+                gain,
+                iteration_time,
+                improvement);
+        if (number_of_iterations % parameters.adaptive_segment_length == 0) {
+            update_weights(destroy_operator_arms, parameters.adaptive_reaction_factor, parameters.deterministic);
+            update_weights(destroy_size_arms, parameters.adaptive_reaction_factor, parameters.deterministic);
+        }
+
         // Update best solution.
         //std::cout << "weight " << solution.weight() << std::endl;
-        if (output.solution.weight() < solution.weight()){
-            std::stringstream ss;
-            ss << "iteration " << output.iterations;
-            algorithm_formatter.update_solution(solution, ss.str());
+        if (best_weight < solution.weight()) {
+            best_weight = solution.weight();
             iterations_without_improvment = 0;
+            if (best_weight > shared.best_weight) {
+                shared.number_of_iterations += number_of_iterations - number_of_iterations_reported;
+                number_of_iterations_reported = number_of_iterations;
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                if (output.solution.weight() < solution.weight()) {
+                    std::stringstream ss;
+                    if (parameters.number_of_threads > 1)
+                        ss << "walker " << walker_id << " ";
+                    ss << "iteration " << number_of_iterations;
+                    output.iterations = shared.number_of_iterations;
+                    report_statistics(destroy_operators, destroy_operators_reported, output.destroy_operators);
+                    report_statistics(destroy_sizes, destroy_sizes_reported, output.destroy_sizes);
+                    algorithm_formatter.update_solution(solution, ss.str());
+                    shared.best_weight = output.solution.weight();
+                }
+            }
         }
     }
+    // The loop is left at the start of an iteration which is not executed.
+    number_of_iterations--;
+    shared.number_of_iterations += number_of_iterations - number_of_iterations_reported;
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    report_statistics(destroy_operators, destroy_operators_reported, output.destroy_operators);
+    report_statistics(destroy_sizes, destroy_sizes_reported, output.destroy_sizes);
+}
+
+}
+
+const LargeNeighborhoodSearchOutput stablesolver::stable::large_neighborhood_search(
+        const Instance& instance,
+        const LargeNeighborhoodSearchParameters& parameters)
+{
+    LargeNeighborhoodSearchOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Large neighborhood search");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce)
+        return solve_reduced_instance(large_neighborhood_search, instance, parameters, algorithm_formatter, output);
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(large_neighborhood_search, instance, parameters, algorithm_formatter, output);
+
+    algorithm_formatter.print_header();
+
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    // Compute initial greedy solution.
+    GreedyParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    greedy_parameters.timer = parameters.timer;
+    greedy_parameters.reduction_parameters.reduce = false;
+    greedy_parameters.clique_cover_parameters.enable = false;
+    Solution solution = greedy_gwmin(instance, greedy_parameters).solution;
+    algorithm_formatter.update_solution(solution, "initial solution");
+
+    // Compute the Lagrangian relaxation bound in a separate thread. Its
+    // bound is reported by the main thread.
+    std::atomic<Weight> lagrangian_bound(output.bound);
+    bool lagrangian_end = false;
+    std::exception_ptr lagrangian_exception = nullptr;
+    std::thread lagrangian_thread;
+    if (parameters.lagrangian_relaxation_bound) {
+        LagrangianRelaxationParameters lagrangian_parameters;
+        lagrangian_parameters.verbosity_level = 0;
+        lagrangian_parameters.timer = parameters.timer;
+        lagrangian_parameters.timer.add_end_boolean(&lagrangian_end);
+        lagrangian_parameters.reduction_parameters.reduce = false;
+        lagrangian_parameters.clique_cover_parameters = parameters.clique_cover_parameters;
+        lagrangian_parameters.new_solution_callback
+            = [&lagrangian_bound](
+                    const Output& lagrangian_output,
+                    const std::string&)
+            {
+                Weight bound = lagrangian_bound;
+                while (lagrangian_output.bound < bound
+                        && !lagrangian_bound.compare_exchange_weak(bound, lagrangian_output.bound)) { }
+            };
+        lagrangian_thread = std::thread([
+                &instance,
+                &lagrangian_exception,
+                lagrangian_parameters]()
+                {
+                    try {
+                        lagrangian_relaxation(instance, lagrangian_parameters);
+                    } catch (...) {
+                        lagrangian_exception = std::current_exception();
+                    }
+                });
+    }
+
+    // Run the walkers. Each walker runs its own search from the initial
+    // solution; the best solution is shared through the output.
+    LargeNeighborhoodSearchShared shared;
+    shared.best_weight = output.solution.weight();
+    shared.bound = output.bound;
+    Counter number_of_threads = (std::max)((Counter)1, parameters.number_of_threads);
+    std::mt19937_64 generator(parameters.seed);
+    std::vector<Seed> walker_seeds(number_of_threads);
+    for (Counter walker_id = 0; walker_id < number_of_threads; ++walker_id)
+        walker_seeds[walker_id] = generator();
+    std::exception_ptr walkers_exception = nullptr;
+    auto run_walker = [&instance, &parameters, &clique_cover, &lagrangian_bound, &solution, &shared, &algorithm_formatter, &output, &walkers_exception, &walker_seeds](
+            Counter walker_id)
+    {
+        try {
+            large_neighborhood_search_walker(
+                    instance,
+                    parameters,
+                    (walker_id == 0)? &clique_cover: nullptr,
+                    (walker_id == 0 && parameters.lagrangian_relaxation_bound)? &lagrangian_bound: nullptr,
+                    solution,
+                    shared,
+                    algorithm_formatter,
+                    output,
+                    walker_id,
+                    walker_seeds[walker_id]);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            walkers_exception = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (Counter walker_id = 1; walker_id < number_of_threads; ++walker_id)
+        threads.push_back(std::thread(run_walker, walker_id));
+    run_walker(0);
+    for (std::thread& thread: threads)
+        thread.join();
+    output.iterations = shared.number_of_iterations;
+
+    if (lagrangian_thread.joinable()) {
+        lagrangian_end = true;
+        lagrangian_thread.join();
+        if (lagrangian_exception)
+            std::rethrow_exception(lagrangian_exception);
+        if (lagrangian_bound < output.bound)
+            algorithm_formatter.update_bound(lagrangian_bound, "lagrangian relaxation");
+    }
+    if (walkers_exception)
+        std::rethrow_exception(walkers_exception);
 
     algorithm_formatter.end();
     return output;
 }
-
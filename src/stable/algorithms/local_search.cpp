@@ -4,8 +4,26 @@
 
 #include "localsearchsolver/best_first_local_search.hpp"
 
+#include <thread>
+
 using namespace stablesolver::stable;
 
+void stablesolver::stable::compute_add_gains(
+        VertexId number_of_vertices,
+        const Weight* weights,
+        const Weight* neighbor_weights,
+        const int8_t* in,
+        Weight* gains)
+{
+    // Branch-free, so that the loop is vectorized.
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+        Weight mask = -(Weight)in[vertex_id];
+        gains[vertex_id] = weights[vertex_id]
+            - neighbor_weights[vertex_id]
+            - (mask & (2 * weights[vertex_id]));
+    }
+}
+
 namespace
 {
 
@@ -23,6 +41,12 @@ public:
         /** Enable (2-1)-swap neighborhood. */
         bool swap_2_1 = true;
         bool shuffle_neighborhood_order = true;
+
+        /**
+         * Number of perturbations generated by 'perturbations'; -1 for one
+         * perturbation per vertex.
+         */
+        Counter number_of_perturbations = -1;
     };
 
     LocalScheme(
@@ -33,10 +57,29 @@ public:
         vertices_(instance.number_of_vertices()),
         neighbors_(instance_.number_of_vertices()),
         free_vertices_(instance_.number_of_vertices()),
-        free_vertices_2_(instance_.number_of_vertices())
+        free_vertices_2_(instance_.number_of_vertices()),
+        perturbation_vertices_(instance_.number_of_vertices()),
+        weights_(instance_.number_of_vertices()),
+        gains_(instance_.number_of_vertices()),
+        zobrist_keys_(instance_.number_of_vertices())
     {
         // Initialize vertices_.
         std::iota(vertices_.begin(), vertices_.end(), 0);
+
+        // Initialize weights_.
+        for (VertexId vertex_id = 0;
+                vertex_id < instance_.number_of_vertices();
+                ++vertex_id) {
+            weights_[vertex_id] = instance_.vertex(vertex_id).weight;
+        }
+
+        // Initialize zobrist_keys_.
+        std::mt19937_64 generator(0);
+        for (VertexId vertex_id = 0;
+                vertex_id < instance_.number_of_vertices();
+                ++vertex_id) {
+            zobrist_keys_[vertex_id] = generator();
+        }
     }
 
     /*
@@ -53,30 +96,47 @@ public:
      * Solutions
      */
 
-    struct SolutionVertex
+    /**
+     * Solution.
+     *
+     * The data of the vertices are stored in separate arrays, so that the
+     * gains of the vertices are evaluated by vectorized loops.
+     */
+    struct Solution
     {
-        /**
-         * in == true iff the vertex is in the solution.
-         */
-        bool in = false;
+        /** in[vertex_id] == 1 iff the vertex is in the solution. */
+        std::vector<int8_t> in;
 
         /**
-         * neighbor_weight = p iff the sum of the weights of the neighbors of j
-         * which are in the solution is equal to p.
+         * neighbor_weights[vertex_id] = p iff the sum of the weights of the
+         * neighbors of vertex_id which are in the solution is equal to p.
          */
-        Weight neighbor_weight = 0;
-    };
+        std::vector<Weight> neighbor_weights;
 
-    struct Solution
-    {
-        std::vector<SolutionVertex> vertices;
         Weight weight = 0;
+
+        /** Zobrist hash of the solution. */
+        uint64_t hash = 0;
+
+        /**
+         * Vertices which are not in the solution and whose weight is greater
+         * than the weight of their neighbors in the solution, that is,
+         * vertices whose addition improves the solution.
+         */
+        optimizationtools::IndexedSet improving_vertices = optimizationtools::IndexedSet(0);
     };
 
     inline Solution empty_solution() const
     {
         Solution solution;
-        solution.vertices.resize(instance_.number_of_vertices());
+        solution.in.resize(instance_.number_of_vertices(), 0);
+        solution.neighbor_weights.resize(instance_.number_of_vertices(), 0);
+        solution.improving_vertices = optimizationtools::IndexedSet(instance_.number_of_vertices());
+        for (VertexId vertex_id = 0;
+                vertex_id < instance_.number_of_vertices();
+                ++vertex_id) {
+            update_improving_vertices(solution, vertex_id);
+        }
         return solution;
     }
 
@@ -85,13 +145,24 @@ public:
             std::mt19937_64& generator)
     {
         Solution solution = empty_solution();
+        if (!initial_vertices_.empty()) {
+            for (VertexId vertex_id: initial_vertices_)
+                add(solution, vertex_id);
+            return solution;
+        }
         std::shuffle(vertices_.begin(), vertices_.end(), generator);
         for (VertexId vertex_id: vertices_)
-            if (solution.vertices[vertex_id].neighbor_weight == 0)
+            if (solution.neighbor_weights[vertex_id] == 0)
                 add(solution, vertex_id);
         return solution;
     }
 
+    /** Set the vertices of the solution returned by 'initial_solution'. */
+    inline void set_initial_vertices(const std::vector<VertexId>& vertices)
+    {
+        initial_vertices_ = vertices;
+    }
+
     inline GlobalCost global_cost(const Solution& solution) const
     {
         return {
@@ -131,34 +202,28 @@ public:
             for (Counter neighborhood: neighborhoods) {
                 switch (neighborhood) {
                 case 0: { // Add neighborhood.
-                    std::shuffle(vertices_.begin(), vertices_.end(), generator);
-                    VertexId vertex_id_best = -1;
-                    GlobalCost c_best = global_cost(solution);
-                    for (VertexId vertex_id: vertices_) {
-                        if (vertex_id == tabu.vertex_id)
-                            continue;
-                        if (contains(solution, vertex_id))
-                            continue;
-                        GlobalCost c = cost_add(solution, vertex_id, c_best);
-                        if (c >= c_best)
-                            continue;
-                        if (vertex_id_best != -1
-                                && !localsearchsolver::dominates(c, c_best)) {
-                            continue;
-                        }
-                        vertex_id_best = vertex_id;
-                        c_best = c;
+                    // Draw a random improving vertex.
+                    const optimizationtools::IndexedSet& improving_vertices = solution.improving_vertices;
+                    VertexPos number_of_candidates = improving_vertices.size();
+                    if (tabu.vertex_id != -1
+                            && improving_vertices.contains(tabu.vertex_id)) {
+                        number_of_candidates--;
                     }
-                    if (vertex_id_best != -1) {
-                        improved = true;
-                        // Apply perturbation.
-                        add(solution, vertex_id_best);
-                        if (global_cost(solution) != c_best) {
-                            throw std::logic_error(
-                                    "Add. Costs do not match:\n"
-                                    "* Expected new cost: " + localsearchsolver::to_string(c_best) + "\n"
-                                    + "* Actual new cost: " + localsearchsolver::to_string(global_cost(solution)) + "\n");
-                        }
+                    if (number_of_candidates == 0)
+                        break;
+                    std::uniform_int_distribution<VertexPos> distribution(0, improving_vertices.size() - 1);
+                    VertexId vertex_id = tabu.vertex_id;
+                    while (vertex_id == tabu.vertex_id)
+                        vertex_id = *(improving_vertices.begin() + distribution(generator));
+                    GlobalCost c = cost_add(solution, vertex_id, global_cost(solution));
+                    improved = true;
+                    // Apply perturbation.
+                    add(solution, vertex_id);
+                    if (global_cost(solution) != c) {
+                        throw std::logic_error(
+                                "Add. Costs do not match:\n"
+                                "* Expected new cost: " + localsearchsolver::to_string(c) + "\n"
+                                + "* Actual new cost: " + localsearchsolver::to_string(global_cost(solution)) + "\n");
                     }
                     break;
                 } case 1: { // (2-1)-swap neighborhood.
@@ -180,7 +245,7 @@ public:
                         // Update free_vertices_
                         free_vertices_.clear();
                         for (const VertexEdge& edge: instance_.vertex(vertex_id_in).edges)
-                            if (solution.vertices[edge.vertex_id].neighbor_weight
+                            if (solution.neighbor_weights[edge.vertex_id]
                                     == instance_.vertex(vertex_id_in).weight)
                                 free_vertices_.add(edge.vertex_id);
                         if (free_vertices_.size() <= 2)
@@ -262,16 +327,48 @@ public:
 
     inline std::vector<Perturbation> perturbations(
             const Solution& solution,
-            std::mt19937_64&)
+            std::mt19937_64& generator)
     {
         std::vector<Perturbation> perturbations;
-        for (VertexId vertex_id: vertices_) {
-            GlobalCost c = (contains(solution, vertex_id))?
-                cost_remove(solution, vertex_id, localsearchsolver::worst<GlobalCost>()):
-                cost_add(solution, vertex_id, localsearchsolver::worst<GlobalCost>());
+        Counter number_of_perturbations = parameters_.number_of_perturbations;
+        if (number_of_perturbations == -1
+                || number_of_perturbations >= (Counter)vertices_.size()) {
+            compute_add_gains(
+                    instance_.number_of_vertices(),
+                    weights_.data(),
+                    solution.neighbor_weights.data(),
+                    solution.in.data(),
+                    gains_.data());
+            perturbations.resize(vertices_.size());
+            for (VertexPos vertex_pos = 0;
+                    vertex_pos < (VertexPos)vertices_.size();
+                    ++vertex_pos) {
+                VertexId vertex_id = vertices_[vertex_pos];
+                perturbations[vertex_pos].vertex_id = vertex_id;
+                perturbations[vertex_pos].global_cost = {-(solution.weight + gains_[vertex_id])};
+            }
+            return perturbations;
+        }
+
+        // Each perturbation is the best of two random vertices. The number of
+        // draws is bounded in case of many collisions.
+        perturbation_vertices_.clear();
+        std::uniform_int_distribution<VertexPos> distribution(0, vertices_.size() - 1);
+        for (Counter draw_id = 0;
+                draw_id < 4 * number_of_perturbations
+                && (Counter)perturbations.size() < number_of_perturbations;
+                ++draw_id) {
+            VertexId vertex_id_1 = vertices_[distribution(generator)];
+            VertexId vertex_id_2 = vertices_[distribution(generator)];
+            GlobalCost c_1 = cost_perturbation(solution, vertex_id_1);
+            GlobalCost c_2 = cost_perturbation(solution, vertex_id_2);
+            VertexId vertex_id = (c_2 < c_1)? vertex_id_2: vertex_id_1;
+            if (perturbation_vertices_.contains(vertex_id))
+                continue;
+            perturbation_vertices_.add(vertex_id);
             Perturbation perturbation;
             perturbation.vertex_id = vertex_id;
-            perturbation.global_cost = c;
+            perturbation.global_cost = (c_2 < c_1)? c_2: c_1;
             perturbations.push_back(perturbation);
         }
         return perturbations;
@@ -293,23 +390,36 @@ public:
      * Best first local search.
      */
 
-    using CompactSolution = std::vector<bool>;
+    struct CompactSolution
+    {
+        /** Zobrist hash of the solution. */
+        uint64_t hash;
+
+        /** vertices[vertex_id] == true iff the vertex is in the solution. */
+        std::vector<bool> vertices;
+    };
 
+    /**
+     * Hasher of the compact solutions.
+     *
+     * The hash is maintained incrementally in the solution, so hashing a
+     * compact solution takes constant time, and the vertices are only
+     * compared when the hashes are equal.
+     */
     struct CompactSolutionHasher
     {
-        std::hash<CompactSolution> hasher;
-
         inline bool operator()(
                 const std::shared_ptr<CompactSolution>& compact_solution_1,
                 const std::shared_ptr<CompactSolution>& compact_solution_2) const
         {
-            return *compact_solution_1 == *compact_solution_2;
+            return compact_solution_1->hash == compact_solution_2->hash
+                && compact_solution_1->vertices == compact_solution_2->vertices;
         }
 
         inline std::size_t operator()(
                 const std::shared_ptr<CompactSolution>& compact_solution) const
         {
-            return hasher(*compact_solution);
+            return compact_solution->hash;
         }
     };
 
@@ -321,10 +431,10 @@ public:
         for (VertexId vertex_id = 0;
                 vertex_id < instance_.number_of_vertices();
                 ++vertex_id) {
-            if (solution.vertices[vertex_id].in)
+            if (solution.in[vertex_id])
                 vertices[vertex_id] = true;
         }
-        return vertices;
+        return {solution.hash, vertices};
     }
 
     Solution compact2solution(const CompactSolution& compact_solution)
@@ -333,7 +443,7 @@ public:
         for (VertexId vertex_id = 0;
                 vertex_id < instance_.number_of_vertices();
                 ++vertex_id) {
-            if (compact_solution[vertex_id])
+            if (compact_solution.vertices[vertex_id])
                 add(solution, vertex_id);
         }
         return solution;
@@ -394,7 +504,7 @@ private:
             const Solution& solution,
             VertexId vertex_id) const
     {
-        return solution.vertices[vertex_id].in;
+        return solution.in[vertex_id];
     }
 
     inline void add(
@@ -410,11 +520,14 @@ private:
         for (const VertexEdge& edge: instance_.vertex(vertex_id).edges) {
             if (contains(solution, edge.vertex_id))
                 remove(solution, edge.vertex_id);
-            solution.vertices[edge.vertex_id].neighbor_weight += weight;
+            solution.neighbor_weights[edge.vertex_id] += weight;
+            update_improving_vertices(solution, edge.vertex_id);
         }
 
-        solution.vertices[vertex_id].in = true;
+        solution.in[vertex_id] = 1;
         solution.weight += weight;
+        solution.hash ^= zobrist_keys_[vertex_id];
+        solution.improving_vertices.remove(vertex_id);
     }
 
     inline void remove(
@@ -424,11 +537,29 @@ private:
         assert(vertex_id >= 0);
         assert(contains(solution, vertex_id));
 
-        solution.vertices[vertex_id].in = false;
+        solution.in[vertex_id] = 0;
         Weight weight = instance_.vertex(vertex_id).weight;
         solution.weight -= weight;
-        for (const VertexEdge& edge: instance_.vertex(vertex_id).edges)
-            solution.vertices[edge.vertex_id].neighbor_weight -= weight;
+        solution.hash ^= zobrist_keys_[vertex_id];
+        update_improving_vertices(solution, vertex_id);
+        for (const VertexEdge& edge: instance_.vertex(vertex_id).edges) {
+            solution.neighbor_weights[edge.vertex_id] -= weight;
+            update_improving_vertices(solution, edge.vertex_id);
+        }
+    }
+
+    /** Update the membership of a vertex in 'improving_vertices'. */
+    inline void update_improving_vertices(
+            Solution& solution,
+            VertexId vertex_id) const
+    {
+        if (!contains(solution, vertex_id)
+                && instance_.vertex(vertex_id).weight
+                > solution.neighbor_weights[vertex_id]) {
+            solution.improving_vertices.add(vertex_id);
+        } else {
+            solution.improving_vertices.remove(vertex_id);
+        }
     }
 
     /*
@@ -453,10 +584,20 @@ private:
         return {
             -(solution.weight
                     + instance_.vertex(vertex_id).weight
-                    - solution.vertices[vertex_id].neighbor_weight),
+                    - solution.neighbor_weights[vertex_id]),
         };
     }
 
+    /** Get the cost of the solution after adding or removing a vertex. */
+    inline GlobalCost cost_perturbation(
+            const Solution& solution,
+            VertexId vertex_id) const
+    {
+        return (contains(solution, vertex_id))?
+            cost_remove(solution, vertex_id, localsearchsolver::worst<GlobalCost>()):
+            cost_add(solution, vertex_id, localsearchsolver::worst<GlobalCost>());
+    }
+
     /*
      * Private attributes.
      */
@@ -470,9 +611,147 @@ private:
     optimizationtools::IndexedSet neighbors_;
     optimizationtools::IndexedSet free_vertices_;
     optimizationtools::IndexedSet free_vertices_2_;
+    optimizationtools::IndexedSet perturbation_vertices_;
+
+    /** For each vertex, its weight. */
+    std::vector<Weight> weights_;
+
+    /** Buffer for the gains computed by 'compute_add_gains'. */
+    std::vector<Weight> gains_;
+
+    /** For each vertex, random key of the Zobrist hash of the solutions. */
+    std::vector<uint64_t> zobrist_keys_;
+
+    /**
+     * Vertices of the solution returned by 'initial_solution'; if empty, a
+     * random solution is returned.
+     */
+    std::vector<VertexId> initial_vertices_;
 
 };
 
+/**
+ * Structure for the elite solution published by an island.
+ */
+struct LocalSearchElite
+{
+    /** Weight of the solution. */
+    Weight weight = -1;
+
+    /** Vertices of the solution. */
+    std::vector<VertexId> vertices;
+};
+
+void local_search_islands(
+        const Instance& instance,
+        const LocalSearchParameters& parameters,
+        AlgorithmFormatter& algorithm_formatter)
+{
+    Counter number_of_islands = parameters.number_of_islands;
+
+    // Elite solution of each island. The slots are only accessed through the
+    // atomic shared_ptr operations, which may use a lock internally.
+    std::vector<std::shared_ptr<const LocalSearchElite>> elites(
+            number_of_islands,
+            std::make_shared<const LocalSearchElite>());
+
+    std::mutex mutex;
+    std::exception_ptr exception = nullptr;
+    auto run_island = [&instance, &parameters, &algorithm_formatter,
+         number_of_islands, &elites, &mutex, &exception](
+                 Counter island_id)
+    {
+        try {
+            LocalScheme::Parameters parameters_local_scheme;
+            parameters_local_scheme.number_of_perturbations = parameters.number_of_perturbations;
+            LocalScheme local_scheme(instance, parameters_local_scheme);
+            for (Counter epoch = 0; !parameters.timer.needs_to_end(); ++epoch) {
+                localsearchsolver::BestFirstLocalSearchParameters<LocalScheme> llsbfls_parameters;
+                llsbfls_parameters.verbosity_level = 0;
+                llsbfls_parameters.timer = parameters.timer;
+                llsbfls_parameters.timer.set_time_limit(
+                        parameters.timer.elapsed_time() + (std::min)(
+                            parameters.timer.remaining_time(),
+                            parameters.migration_interval));
+                llsbfls_parameters.maximum_number_of_nodes = parameters.maximum_number_of_nodes;
+                llsbfls_parameters.number_of_threads_1 = 1;
+                llsbfls_parameters.number_of_threads_2 = 1;
+                llsbfls_parameters.initial_solution_ids = {0};
+                llsbfls_parameters.seed = parameters.seed
+                    + epoch * number_of_islands + island_id;
+                llsbfls_parameters.new_solution_callback
+                    = [&instance, &algorithm_formatter, &mutex, island_id](
+                            const localsearchsolver::Output<LocalScheme>& ls_output)
+                    {
+                        Solution solution(instance);
+                        for (VertexId vertex_id = 0;
+                                vertex_id < instance.number_of_vertices();
+                                ++vertex_id) {
+                            if (ls_output.solution_pool.best().in[vertex_id])
+                                solution.add(vertex_id);
+                        }
+                        std::lock_guard<std::mutex> lock(mutex);
+                        algorithm_formatter.update_solution(
+                                solution,
+                                "island " + std::to_string(island_id));
+                    };
+                auto ls_output = best_first_local_search(local_scheme, llsbfls_parameters);
+                bool finished = !llsbfls_parameters.timer.needs_to_end();
+
+                // Publish the elite solution of the island.
+                const LocalScheme::Solution& solution = ls_output.solution_pool.best();
+                std::shared_ptr<const LocalSearchElite> elite = std::atomic_load(&elites[island_id]);
+                if (solution.weight > elite->weight) {
+                    auto elite_new = std::make_shared<LocalSearchElite>();
+                    elite_new->weight = solution.weight;
+                    for (VertexId vertex_id = 0;
+                            vertex_id < instance.number_of_vertices();
+                            ++vertex_id) {
+                        if (solution.in[vertex_id])
+                            elite_new->vertices.push_back(vertex_id);
+                    }
+                    elite = elite_new;
+                    std::atomic_store(&elites[island_id], elite);
+                }
+
+                // Receive the elite solutions of the other islands.
+                std::shared_ptr<const LocalSearchElite> start = elite;
+                for (Counter island_id_2 = 0;
+                        island_id_2 < number_of_islands;
+                        ++island_id_2) {
+                    if (island_id_2 == island_id)
+                        continue;
+                    if (parameters.migration_topology == MigrationTopology::Ring
+                            && island_id_2 != (island_id + number_of_islands - 1) % number_of_islands) {
+                        continue;
+                    }
+                    std::shared_ptr<const LocalSearchElite> immigrant = std::atomic_load(&elites[island_id_2]);
+                    if (immigrant->weight > start->weight)
+                        start = immigrant;
+                }
+
+                // Stop if the search of the epoch ended before its time limit
+                // and there is no better solution to start from.
+                if (finished && start == elite)
+                    break;
+                local_scheme.set_initial_vertices(start->vertices);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            exception = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (Counter island_id = 1; island_id < number_of_islands; ++island_id)
+        threads.push_back(std::thread(run_island, island_id));
+    run_island(0);
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+}
+
 }
 
 const Output stablesolver::stable::local_search(
@@ -487,10 +766,26 @@ const Output stablesolver::stable::local_search(
     if (parameters.reduction_parameters.reduce)
         return solve_reduced_instance(local_search, instance, parameters, algorithm_formatter, output);
 
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(local_search, instance, parameters, algorithm_formatter, output);
+
     algorithm_formatter.print_header();
 
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    // Island model.
+    if (parameters.number_of_islands > 1) {
+        local_search_islands(instance, parameters, algorithm_formatter);
+        algorithm_formatter.end();
+        return output;
+    }
+
     // Create LocalScheme.
     LocalScheme::Parameters parameters_local_scheme;
+    parameters_local_scheme.number_of_perturbations = parameters.number_of_perturbations;
     LocalScheme local_scheme(instance, parameters_local_scheme);
 
     // Run A*.
@@ -510,7 +805,7 @@ const Output stablesolver::stable::local_search(
             for (VertexId vertex_id = 0;
                     vertex_id < instance.number_of_vertices();
                     ++vertex_id) {
-                if (ls_output.solution_pool.best().vertices[vertex_id].in)
+                if (ls_output.solution_pool.best().in[vertex_id])
                     solution.add(vertex_id);
             }
             algorithm_formatter.update_solution(solution, "");
@@ -3,8 +3,150 @@
 #include "stablesolver/stable/algorithm_formatter.hpp"
 #include "stablesolver/stable/algorithms/greedy.hpp"
 
+#include "optimizationtools/containers/indexed_binary_heap.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 using namespace stablesolver::stable;
 
+namespace
+{
+
+/**
+ * Structure that stores a solution shared between the walkers.
+ */
+struct LocalSearchRowWeightingElite
+{
+    /** Weight of the solution. */
+    Weight weight = -1;
+
+    /** Vertices of the solution. */
+    std::vector<VertexId> vertices;
+};
+
+/**
+ * Structure shared by the walkers of a row weighting local search.
+ *
+ * The best solution is exchanged through the atomic shared_ptr operations,
+ * so a walker only synchronizes with the others for the copy of a pointer.
+ * These operations are not lock-free: libstdc++ implements them with an
+ * internal pool of mutexes. The mutex below only protects the algorithm
+ * formatter.
+ */
+struct LocalSearchRowWeightingShared
+{
+    /**
+     * Best solution; only accessed through the atomic shared_ptr operations,
+     * which may use a lock internally.
+     */
+    std::shared_ptr<const LocalSearchRowWeightingElite> best
+        = std::make_shared<const LocalSearchRowWeightingElite>();
+
+    /** Weight of the best solution. */
+    std::atomic<Weight> best_weight{-1};
+
+    /** Bound. */
+    std::atomic<Weight> bound{-1};
+
+    /** For each component, its bound. */
+    std::vector<std::atomic<Weight>> component_bounds;
+
+    /** Total number of iterations reported by the walkers. */
+    std::atomic<Counter> number_of_iterations{0};
+
+    /** Mutex protecting the algorithm formatter. */
+    std::mutex mutex;
+};
+
+/**
+ * Publish a feasible solution if it is better than the shared best solution.
+ *
+ * Return 'true' iff the solution has been published.
+ */
+bool publish(
+        LocalSearchRowWeightingShared& shared,
+        const Solution& solution)
+{
+    if (!solution.feasible()
+            || solution.weight() <= shared.best_weight.load())
+        return false;
+    auto elite = std::make_shared<LocalSearchRowWeightingElite>();
+    elite->weight = solution.weight();
+    elite->vertices.assign(
+            solution.vertices().begin(),
+            solution.vertices().end());
+    std::shared_ptr<const LocalSearchRowWeightingElite> best = std::atomic_load(&shared.best);
+    std::shared_ptr<const LocalSearchRowWeightingElite> elite_const = elite;
+    do {
+        if (best->weight >= elite->weight)
+            return false;
+    } while (!std::atomic_compare_exchange_weak(&shared.best, &best, elite_const));
+    Weight best_weight = shared.best_weight.load();
+    while (best_weight < elite->weight
+            && !shared.best_weight.compare_exchange_weak(best_weight, elite->weight)) { }
+    return true;
+}
+
+/**
+ * Run the walkers of a row weighting local search.
+ *
+ * Walker 0 uses the generator given as parameter; the other walkers use
+ * generators seeded from it.
+ */
+template <typename Walker>
+void run_walkers(
+        Counter number_of_threads,
+        std::mt19937_64& generator,
+        const Walker& walker)
+{
+    number_of_threads = (std::max)((Counter)1, number_of_threads);
+    std::vector<std::mt19937_64> generators;
+    for (Counter walker_id = 1; walker_id < number_of_threads; ++walker_id)
+        generators.push_back(std::mt19937_64(generator()));
+    std::mutex mutex;
+    std::exception_ptr exception = nullptr;
+    auto run_walker = [&generator, &walker, &generators, &mutex, &exception](
+            Counter walker_id)
+    {
+        try {
+            walker(
+                    (walker_id == 0)? generator: generators[walker_id - 1],
+                    walker_id);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            exception = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (Counter walker_id = 1; walker_id < number_of_threads; ++walker_id)
+        threads.push_back(std::thread(run_walker, walker_id));
+    run_walker(0);
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+}
+
+/**
+ * Get the comment of a solution found by a walker.
+ */
+std::string walker_comment(
+        Counter number_of_threads,
+        Counter walker_id,
+        Counter number_of_iterations)
+{
+    std::stringstream ss;
+    if (number_of_threads > 1)
+        ss << "walker " << walker_id << " ";
+    ss << "iteration " << number_of_iterations;
+    return ss.str();
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -23,8 +165,21 @@ struct LocalSearchRowWeighting1Component
     /** Number of iterations without improvment. */
     Counter iterations_without_improvment = 0;
 
-    /** When to start optimizing next component. */
-    Counter iteration_max;
+    /**
+     * Boolean indicating if the component is not scheduled anymore, either
+     * because it has a single vertex or because its best solution is
+     * optimal.
+     */
+    bool retired = false;
+
+    /**
+     * Factor applied to the number of edges of the component to get the
+     * number of iterations of its slices.
+     */
+    double share = 1;
+
+    /** Weight of the best solution of the component at the start of its slice. */
+    Weight slice_start_weight = 0;
 };
 
 struct LocalSearchRowWeighting1Vertex
@@ -36,99 +191,419 @@ struct LocalSearchRowWeighting1Vertex
     Counter last_removal = -1;
 
     Counter iterations = 0;
+
+    /**
+     * Sum of the penalties of the edges of the vertex whose other end is in
+     * the solution.
+     */
+    Weight score = 0;
+
+    /** Epoch at which the score has been computed. */
+    Counter score_epoch = 0;
 };
 
-const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weighting_1(
-        const Instance& instance,
-        std::mt19937_64& generator,
-        const LocalSearchRowWeighting1Parameters& parameters)
+struct LocalSearchRowWeighting1Edge
 {
-    LocalSearchRowWeighting1Output output(instance);
-    AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Row weighting local search 1");
+    /** Penalty. */
+    Penalty penalty = 1;
 
-    // Reduction.
-    if (parameters.reduction_parameters.reduce) {
-        return solve_reduced_instance(
-                [&generator](
-                    const Instance& instance,
-                    const Parameters& parameters)
-                {
-                    return local_search_row_weighting_1(
-                            instance,
-                            generator,
-                            static_cast<const LocalSearchRowWeighting1Parameters&>(parameters));
-                },
-                instance,
-                parameters,
-                algorithm_formatter,
-                output);
-    }
+    /** Epoch at which the penalty has been updated, modulo 2^16. */
+    uint16_t epoch = 0;
+};
 
-    algorithm_formatter.print_header();
+/**
+ * Key of a vertex in the heap of the vertices outside of the solution.
+ *
+ * The score is compared as 'score * 2^epoch', that is, in the scale of the
+ * penalties of epoch 0. A negative score is lower than any other key.
+ */
+struct LocalSearchRowWeighting1Key
+{
+    /** Score of the vertex. */
+    Weight score;
 
-    // Compute initial greedy solution.
-    GreedyParameters greedy_parameters;
-    greedy_parameters.verbosity_level = 0;
-    greedy_parameters.timer = parameters.timer;
-    greedy_parameters.reduction_parameters.reduce = false;
-    Solution solution = greedy_gwmin(instance, greedy_parameters).solution;
-    algorithm_formatter.update_solution(solution, "initial solution");
+    /** Epoch at which the score has been computed. */
+    Counter epoch;
 
-    Solution solution_best(solution);
+    /** Timestamp of the vertex. */
+    Counter timestamp;
 
-    if (instance.number_of_vertices() == 0) {
-        algorithm_formatter.end();
-        return output;
+    bool operator<(const LocalSearchRowWeighting1Key& key) const
+    {
+        if (epoch == key.epoch) {
+            if (score != key.score)
+                return score < key.score;
+            return timestamp < key.timestamp;
+        }
+        if (score < 0 || key.score < 0)
+            return score < key.score;
+        int comparison = (epoch >= key.epoch)?
+            compare(score, epoch - key.epoch, key.score):
+            -compare(key.score, key.epoch - epoch, score);
+        if (comparison != 0)
+            return comparison < 0;
+        return timestamp < key.timestamp;
+    }
+
+private:
+
+    /** Compare 'score_1 * 2^shift' and 'score_2' without overflow. */
+    static int compare(
+            Weight score_1,
+            Counter shift,
+            Weight score_2)
+    {
+        if (shift == 0 || score_1 == 0)
+            return (score_1 < score_2)? -1: (score_1 > score_2)? 1: 0;
+        if (shift >= 62)
+            return 1;
+        Weight quotient = score_2 >> shift;
+        if (score_1 != quotient)
+            return (score_1 < quotient)? -1: 1;
+        return ((score_2 & ((Weight(1) << shift) - 1)) == 0)? 0: -1;
     }
+};
+
+namespace
+{
+
+/**
+ * Run a walker of the row weighting local search 1.
+ */
+void local_search_row_weighting_1_walker(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeighting1Parameters& parameters,
+        CliqueCover* clique_cover,
+        const Solution& initial_solution,
+        LocalSearchRowWeightingShared& shared,
+        AlgorithmFormatter& algorithm_formatter,
+        LocalSearchRowWeighting1Output& output,
+        Counter walker_id)
+{
+    std::mt19937_64 clique_cover_generator;
+    Solution solution(initial_solution);
+    Solution solution_best(solution);
 
     // Initialize local search structures.
     std::vector<LocalSearchRowWeighting1Vertex> vertices(instance.number_of_vertices());
     for (VertexId vertex_id: solution.vertices())
         vertices[vertex_id].last_addition = 0;
     std::vector<LocalSearchRowWeighting1Component> components(instance.number_of_components());
+
+    // Edge penalties are halved lazily. When a penalty gets too large, the
+    // epoch is incremented, and the penalty of an edge stamped with an older
+    // epoch is divided by 2 for each missed epoch on its next access.
+    std::vector<LocalSearchRowWeighting1Edge> edges(instance.number_of_edges());
+    Counter epoch = 0;
+    auto penalty = [&edges, &epoch](
+            EdgeId edge_id) -> Penalty&
+    {
+        LocalSearchRowWeighting1Edge& edge = edges[edge_id];
+        uint16_t shift = (uint16_t)((uint16_t)epoch - edge.epoch);
+        if (shift != 0) {
+            edge.penalty = (shift >= 15)? 1: ((edge.penalty - 1) >> shift) + 1;
+            edge.epoch = (uint16_t)epoch;
+        }
+        return edge.penalty;
+    };
+
+    // For each vertex, sum of the penalties of its edges whose other end is in
+    // the solution. For a vertex outside of the solution, it is the penalty
+    // of adding it; for a vertex of the solution, the penalty of its
+    // conflicts. A score computed at an older epoch is recomputed on its
+    // next access.
+    auto compute_score = [&instance, &solution, &vertices, &epoch, &penalty](
+            VertexId vertex_id)
+    {
+        Weight score = 0;
+        for (const auto& edge: instance.vertex(vertex_id).edges)
+            if (solution.contains(edge.vertex_id))
+                score += penalty(edge.edge_id);
+        vertices[vertex_id].score = score;
+        vertices[vertex_id].score_epoch = epoch;
+    };
+
+    // For each component, its vertices outside of the solution, by score, and
+    // then by timestamp. Since the penalties only decrease by a factor at
+    // most 2 per epoch, the key of a vertex whose score has not been
+    // recomputed yet is a lower bound of its current key.
+    std::vector<VertexPos> component_positions(instance.number_of_vertices());
+    std::vector<optimizationtools::IndexedBinaryHeap<LocalSearchRowWeighting1Key>> heaps;
     for (ComponentId component_id = 0;
             component_id < instance.number_of_components();
             ++component_id) {
-        components[component_id].iteration_max
-            = ((component_id == 0)? 0: components[component_id - 1].iteration_max)
-            + instance.component(component_id).edges.size();
+        const Component& component = instance.component(component_id);
+        for (VertexPos vertex_pos = 0;
+                vertex_pos < (VertexPos)component.vertices.size();
+                ++vertex_pos) {
+            component_positions[component.vertices[vertex_pos]] = vertex_pos;
+        }
+        heaps.push_back(optimizationtools::IndexedBinaryHeap<LocalSearchRowWeighting1Key>(
+                    component.vertices.size()));
     }
-    std::vector<Penalty> solution_penalties(instance.number_of_edges(), 1);
+    auto update_heap = [&instance, &solution, &vertices, &component_positions, &heaps](
+            VertexId vertex_id)
+    {
+        if (!solution.contains(vertex_id)) {
+            heaps[instance.vertex(vertex_id).component].update_key(
+                    component_positions[vertex_id],
+                    {vertices[vertex_id].score, vertices[vertex_id].score_epoch, vertices[vertex_id].timestamp});
+        }
+    };
+    for (VertexId vertex_id = 0;
+            vertex_id < instance.number_of_vertices();
+            ++vertex_id) {
+        compute_score(vertex_id);
+        update_heap(vertex_id);
+    }
+
+    // Get the score of a vertex, recompute it if necessary.
+    auto score = [&vertices, &epoch, &compute_score, &update_heap](
+            VertexId vertex_id) -> Weight
+    {
+        if (vertices[vertex_id].score_epoch != epoch) {
+            compute_score(vertex_id);
+            update_heap(vertex_id);
+        }
+        return vertices[vertex_id].score;
+    };
+
+    // Add or remove a vertex and update the scores. The solution is updated
+    // after the scores, so that the edges of the vertex are counted exactly
+    // once in a recomputed score. The timestamp of a removed vertex must be
+    // updated before it is pushed back in the heap.
+    auto add = [&instance, &solution, &vertices, &epoch, &component_positions, &heaps, &penalty, &compute_score, &update_heap](
+            VertexId vertex_id)
+    {
+        auto& heap = heaps[instance.vertex(vertex_id).component];
+        heap.update_key(
+                component_positions[vertex_id],
+                {-1, 0, -1});
+        heap.pop();
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (vertices[edge.vertex_id].score_epoch != epoch)
+                compute_score(edge.vertex_id);
+            vertices[edge.vertex_id].score += penalty(edge.edge_id);
+            update_heap(edge.vertex_id);
+        }
+        solution.add(vertex_id);
+    };
+    auto remove = [&instance, &solution, &vertices, &epoch, &penalty, &compute_score, &update_heap](
+            VertexId vertex_id)
+    {
+        if (vertices[vertex_id].score_epoch != epoch)
+            compute_score(vertex_id);
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (vertices[edge.vertex_id].score_epoch != epoch)
+                compute_score(edge.vertex_id);
+            vertices[edge.vertex_id].score -= penalty(edge.edge_id);
+            update_heap(edge.vertex_id);
+        }
+        solution.remove(vertex_id);
+        update_heap(vertex_id);
+    };
+
+    // Sum of the penalties of the edges between the vertex evaluated in the
+    // swap move and each of its neighbors. Needed with parallel edges.
+    std::vector<Weight> neighbor_penalties(instance.number_of_vertices(), 0);
+
+    // Schedule the components. The active components are optimized in turn,
+    // each during a slice whose length is the number of edges of the
+    // component times its share. The share is doubled when the best solution
+    // of the component has improved during its last slice, and halved
+    // otherwise. A component whose best solution reaches its bound is
+    // retired: its best solution is restored and never changes anymore.
+    ComponentId number_of_active_components = 0;
+    ComponentId number_of_optimal_components = 0;
+    for (ComponentId component_id = 0;
+            component_id < instance.number_of_components();
+            ++component_id) {
+        if (instance.component(component_id).vertices.size() == 1) {
+            components[component_id].retired = true;
+        } else {
+            number_of_active_components++;
+        }
+    }
+    auto retire = [&instance, &solution, &solution_best, &components, &number_of_active_components, &number_of_optimal_components, &add, &remove](
+            ComponentId component_id)
+    {
+        components[component_id].retired = true;
+        number_of_active_components--;
+        number_of_optimal_components++;
+        for (VertexId vertex_id: instance.component(component_id).vertices)
+            if (solution.contains(vertex_id) && !solution_best.contains(vertex_id))
+                remove(vertex_id);
+        for (VertexId vertex_id: instance.component(component_id).vertices)
+            if (!solution.contains(vertex_id) && solution_best.contains(vertex_id))
+                add(vertex_id);
+    };
+    auto retire_optimal_components = [&instance, &solution_best, &shared, &components, &retire]()
+    {
+        for (ComponentId component_id = 0;
+                component_id < instance.number_of_components();
+                ++component_id) {
+            if (!components[component_id].retired
+                    && solution_best.weight(component_id)
+                    >= shared.component_bounds[component_id]) {
+                retire(component_id);
+            }
+        }
+    };
+
+    // Print the state of the scheduler if it has changed since last time.
+    ComponentId number_of_optimal_components_printed = -1;
+    ComponentId component_id_focus_printed = -1;
+    auto print_scheduler = [&instance, &parameters, &shared, &algorithm_formatter, &output, &components, &number_of_active_components, &number_of_optimal_components, &number_of_optimal_components_printed, &component_id_focus_printed, walker_id]()
+    {
+        // Active component with the largest share.
+        ComponentId component_id_focus = -1;
+        for (ComponentId component_id = 0;
+                component_id < instance.number_of_components();
+                ++component_id) {
+            if (components[component_id].retired)
+                continue;
+            if (component_id_focus == -1
+                    || components[component_id_focus].share
+                    < components[component_id].share) {
+                component_id_focus = component_id;
+            }
+        }
+        if (number_of_optimal_components == number_of_optimal_components_printed
+                && component_id_focus == component_id_focus_printed) {
+            return;
+        }
+        number_of_optimal_components_printed = number_of_optimal_components;
+        component_id_focus_printed = component_id_focus;
+        std::stringstream ss;
+        if (parameters.number_of_threads > 1)
+            ss << "walker " << walker_id << " ";
+        ss << "optimal " << number_of_optimal_components
+            << "/" << number_of_optimal_components + number_of_active_components;
+        if (component_id_focus != -1) {
+            ss << " focus " << component_id_focus
+                << " x" << components[component_id_focus].share;
+        }
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        output.number_of_optimal_components = (std::max)(
+                output.number_of_optimal_components,
+                number_of_optimal_components);
+        algorithm_formatter.print(ss.str());
+    };
+    retire_optimal_components();
+    print_scheduler();
 
-    ComponentId component_id = 0;
-    for (output.number_of_iterations = 0;
+    ComponentId component_id = -1;
+    // Iteration at which the slice of the current component ends.
+    Counter slice_end = 0;
+    Counter number_of_iterations = 0;
+    // Number of iterations already added to the shared number of iterations.
+    Counter number_of_iterations_reported = 0;
+    for (number_of_iterations = 0;
             !parameters.timer.needs_to_end();
-            ++output.number_of_iterations) {
+            ++number_of_iterations) {
         //std::cout << "it " << iterations << std::endl;
         // Check stop criteria.
         if (parameters.maximum_number_of_iterations != -1
-                && output.number_of_iterations >= parameters.maximum_number_of_iterations)
+                && number_of_iterations >= parameters.maximum_number_of_iterations)
+            break;
+
+        // Refine the clique cover bound, using at most 5% of the time.
+        if (clique_cover != nullptr
+                && number_of_iterations % 1024 == 0
+                && clique_cover->time() < 0.05 * parameters.timer.elapsed_time()
+                && clique_cover->improve(clique_cover_generator)) {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            algorithm_formatter.update_bound(clique_cover->bound(), "clique cover");
+            shared.bound = clique_cover->bound();
+            for (ComponentId component_id = 0;
+                    component_id < instance.number_of_components();
+                    ++component_id) {
+                shared.component_bounds[component_id]
+                    = clique_cover->component_bound(component_id);
+            }
+        }
+        // Stop if the best solution is optimal.
+        if (shared.best_weight == shared.bound)
             break;
 
+        // Retire the components proved optimal by the refined bounds.
+        if (number_of_iterations % 100000 == 0) {
+            retire_optimal_components();
+            print_scheduler();
+        }
+
         // Update best solution
-        if (output.number_of_iterations % 100000 == 0) {
-            if (optimizationtools::is_solution_strictly_better(
-                        objective_direction(),
-                        output.solution.feasible(),
-                        output.solution.objective_value(),
-                        solution_best.feasible(),
-                        solution_best.objective_value())) {
-                std::stringstream ss;
-                ss << "iteration " << output.number_of_iterations;
-                algorithm_formatter.update_solution(solution_best, ss.str());
+        if (number_of_iterations % 100000 == 0
+                && publish(shared, solution_best)) {
+            shared.number_of_iterations += number_of_iterations - number_of_iterations_reported;
+            number_of_iterations_reported = number_of_iterations;
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            output.number_of_iterations = shared.number_of_iterations;
+            algorithm_formatter.update_solution(
+                    solution_best,
+                    walker_comment(parameters.number_of_threads, walker_id, number_of_iterations));
+        }
+
+        // Restart from the shared best solution if the walker lags behind.
+        if (parameters.restart_interval > 0
+                && number_of_iterations > 0
+                && number_of_iterations % parameters.restart_interval == 0
+                && shared.best_weight > solution_best.weight()) {
+            std::shared_ptr<const LocalSearchRowWeightingElite> best = std::atomic_load(&shared.best);
+            std::vector<int8_t> contains(instance.number_of_vertices(), 0);
+            for (VertexId vertex_id: best->vertices)
+                contains[vertex_id] = 1;
+            // The retired components keep their solution, which is optimal.
+            for (VertexId vertex_id = 0;
+                    vertex_id < instance.number_of_vertices();
+                    ++vertex_id) {
+                if (solution.contains(vertex_id)
+                        && !contains[vertex_id]
+                        && !components[instance.vertex(vertex_id).component].retired) {
+                    remove(vertex_id);
+                }
+            }
+            for (VertexId vertex_id: best->vertices) {
+                if (!solution.contains(vertex_id)
+                        && !components[instance.vertex(vertex_id).component].retired) {
+                    add(vertex_id);
+                }
+            }
+            solution_best = solution;
+            for (LocalSearchRowWeighting1Component& component: components) {
+                component.vertex_id_last_added = -1;
+                component.vertex_id_last_removed = -1;
             }
         }
 
         // Compute component
-        if (output.number_of_iterations % (components.back().iteration_max + 1)
-                >= components[component_id].iteration_max) {
-            component_id = (component_id + 1) % instance.number_of_components();
-            while (instance.component(component_id).vertices.size() == 1)
+        if (component_id == -1
+                || components[component_id].retired
+                || number_of_iterations >= slice_end) {
+            // Update the share of the current component.
+            if (component_id != -1 && !components[component_id].retired) {
+                LocalSearchRowWeighting1Component& component = components[component_id];
+                if (solution_best.weight(component_id) > component.slice_start_weight) {
+                    component.share = (std::min)(2 * component.share, 16.0);
+                } else {
+                    component.share = (std::max)(component.share / 2, 1.0 / 16);
+                }
+            }
+            // Stop if all components are optimal.
+            if (number_of_active_components == 0)
+                break;
+            // Start the slice of the next active component.
+            do {
                 component_id = (component_id + 1) % instance.number_of_components();
-            //std::cout << "c " << c << " " << components[c].iteration_max
-                //<< " e " << instance.component(component_id.edges.size()
-                //<< " s " << instance.component(component_id.vertices.size()
+            } while (components[component_id].retired);
+            components[component_id].slice_start_weight = solution_best.weight(component_id);
+            slice_end = number_of_iterations + (std::max)((Counter)1, (Counter)(
+                        components[component_id].share
+                        * instance.component(component_id).edges.size()));
+            //std::cout << "c " << component_id
+                //<< " share " << components[component_id].share
+                //<< " e " << instance.component(component_id).edges.size()
                 //<< std::endl;
         }
         LocalSearchRowWeighting1Component& component = components[component_id];
@@ -146,44 +621,36 @@ const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weig
                         solution_best.add(vertex_id);
                     }
                 }
+                if (solution_best.weight(component_id)
+                        >= shared.component_bounds[component_id]) {
+                    retire(component_id);
+                    break;
+                }
             }
             // Update statistics
             if (component.iterations_without_improvment > 0)
                 component.iterations_without_improvment = 0;
 
-            // Find the best shift move.
+            // Find the best shift move: the vertex of the component outside
+            // of the solution with the smallest score, and which has not been
+            // considered for the longest time.
+            // Keys of vertices whose score is outdated are lower bounds, so
+            // the scores are recomputed until the top of the heap is up to
+            // date.
             VertexId vertex_id_best = -1;
-            Weight p_best = -1;
-            // For each set s of the current solution which belongs to the
-            // currently considered component and is not mandatory.
-            for (auto it_v = solution.vertices().out_begin();
-                    it_v != solution.vertices().out_end();
-                    ++it_v) {
-                VertexId vertex_id = *it_v;
-                if (instance.vertex(vertex_id).component != component_id)
-                    continue;
-                Penalty p = 0;
-                for (const auto& edge: instance.vertex(vertex_id).edges)
-                    if (solution.covers(edge.edge_id) == 1)
-                        p += solution_penalties[edge.edge_id];
-                // Update best move.
-                if (vertex_id_best == -1 // First move considered.
-                        || p_best > p // Strictly better.
-                        // Equivalent, but s has not been considered for a
-                        // longer time.
-                        || (p_best == p
-                            && vertices[vertex_id_best].timestamp
-                            > vertices[vertex_id].timestamp)) {
-                    vertex_id_best = vertex_id;
-                    p_best = p;
-                }
+            for (;;) {
+                if (heaps[component_id].empty())
+                    throw std::runtime_error("vertex_id_best == -1.");
+                vertex_id_best = instance.component(component_id).vertices[
+                    heaps[component_id].top().first];
+                if (vertices[vertex_id_best].score_epoch == epoch)
+                    break;
+                score(vertex_id_best);
             }
-            if (vertex_id_best == -1)
-                throw std::runtime_error("vertex_id_best == -1.");
             // Apply best move
-            solution.add(vertex_id_best);
+            add(vertex_id_best);
             // Update sets
-            vertices[vertex_id_best].timestamp = output.number_of_iterations;
+            vertices[vertex_id_best].timestamp = number_of_iterations;
             vertices[vertex_id_best].last_addition = component.iterations;
             // Update tabu
             component.vertex_id_last_added = vertex_id_best;
@@ -193,6 +660,8 @@ const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weig
                 //<< " v " << solution.number_of_vertices()
                 //<< std::endl;
         }
+        if (component.retired)
+            continue;
 
         // Draw randomly an uncovered edge e.
         std::uniform_int_distribution<EdgeId> d_e(0, solution.number_of_conflicts() - 1);
@@ -213,22 +682,18 @@ const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weig
         for (VertexId vertex_id_1: {instance.edge(edge_id_cur).vertex_id_1, instance.edge(edge_id_cur).vertex_id_2}) {
             if (vertex_id_1 == component.vertex_id_last_added)
                 continue;
-            Penalty p0 = 0;
-            for (const auto& edge: instance.vertex(vertex_id_1).edges)
-                if (solution.covers(edge.edge_id) == 2)
-                    p0 -= solution_penalties[edge.edge_id];
-            solution.remove(vertex_id_1);
+            Weight p0 = -score(vertex_id_1);
             if (p_best == -1 || p0 <= p_best) {
+                for (const auto& edge: instance.vertex(vertex_id_1).edges)
+                    neighbor_penalties[edge.vertex_id] += penalty(edge.edge_id);
                 // For each neighbor s2 of s1 which is neither part of the
                 // solution, nor the last set added, nor mandatory.
                 for (const auto& edge: instance.vertex(vertex_id_1).edges) {
                     if (edge.vertex_id == component.vertex_id_last_removed
                             || solution.contains(edge.vertex_id))
                         continue;
-                    Penalty p = p0;
-                    for (const auto& edge_2: instance.vertex(edge.vertex_id).edges)
-                        if (solution.covers(edge_2.edge_id) == 1)
-                            p += solution_penalties[edge_2.edge_id];
+                    // Score of s2 once s1 is removed.
+                    Weight p = p0 + score(edge.vertex_id) - neighbor_penalties[edge.vertex_id];
                     // If the new solution is better, we update the best move.
                     if (vertex_id_1_best == -1 // First move considered.
                             || p_best > p // Strictly better.
@@ -244,16 +709,17 @@ const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weig
                         p_best = p;
                     }
                 }
+                for (const auto& edge: instance.vertex(vertex_id_1).edges)
+                    neighbor_penalties[edge.vertex_id] = 0;
             }
-            solution.add(vertex_id_1);
         }
         if (vertex_id_1_best != -1) {
             // Apply move
-            solution.remove(vertex_id_1_best);
-            solution.add(vertex_id_2_best);
+            vertices[vertex_id_1_best].timestamp = number_of_iterations;
+            vertices[vertex_id_2_best].timestamp = number_of_iterations;
+            remove(vertex_id_1_best);
+            add(vertex_id_2_best);
             // Update sets
-            vertices[vertex_id_1_best].timestamp = output.number_of_iterations;
-            vertices[vertex_id_2_best].timestamp = output.number_of_iterations;
             vertices[vertex_id_1_best].last_removal  = component.iterations;
             vertices[vertex_id_2_best].last_addition = component.iterations;
             vertices[vertex_id_1_best].iterations += (component.iterations - vertices[vertex_id_1_best].last_addition);
@@ -261,18 +727,28 @@ const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weig
             bool reduce = false;
             for (const auto& edge: instance.vertex(vertex_id_2_best).edges) {
                 if (solution.covers(edge.edge_id) == 2) {
-                    solution_penalties[edge.edge_id]++;
-                    if (solution_penalties[edge.edge_id]
-                            > std::numeric_limits<Penalty>::max() / 2)
+                    Penalty& p = penalty(edge.edge_id);
+                    p++;
+                    // Outdated scores already include the new penalty.
+                    if (vertices[vertex_id_2_best].score_epoch == epoch)
+                        vertices[vertex_id_2_best].score++;
+                    if (vertices[edge.vertex_id].score_epoch == epoch)
+                        vertices[edge.vertex_id].score++;
+                    if (p > std::numeric_limits<Penalty>::max() / 2)
                         reduce = true;
                 }
             }
             if (reduce) {
-                //std::cout << "reduce" << std::endl;
-                for (EdgeId edge_id = 0;
-                        edge_id < instance.number_of_edges();
-                        ++edge_id) {
-                    solution_penalties[edge_id] = (solution_penalties[edge_id] - 1) / 2 + 1;
+                // Halve all penalties lazily.
+                epoch++;
+                // The epochs of the edges are stored on 16 bits; bring all
+                // penalties up to date before they wrap around.
+                if (epoch % 32768 == 0) {
+                    for (EdgeId edge_id = 0;
+                            edge_id < instance.number_of_edges();
+                            ++edge_id) {
+                        penalty(edge_id);
+                    }
                 }
             }
         }
@@ -290,36 +766,26 @@ const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weig
         component.iterations++;
         component.iterations_without_improvment++;
     }
-
-    algorithm_formatter.end();
-    return output;
+    shared.number_of_iterations += number_of_iterations - number_of_iterations_reported;
+    if (publish(shared, solution_best)) {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        output.number_of_iterations = shared.number_of_iterations;
+        algorithm_formatter.update_solution(
+                solution_best,
+                walker_comment(parameters.number_of_threads, walker_id, number_of_iterations));
+    }
 }
 
-////////////////////////////////////////////////////////////////////////////////
-////////////////////////// local_search_row_weighting_2 //////////////////////////
-////////////////////////////////////////////////////////////////////////////////
-
-struct LocalSearchRowWeighting2Vertex
-{
-    Counter timestamp = -1;
-
-    Counter last_addition = -1;
-
-    Counter last_removal = -1;
-
-    Counter iterations = 0;
-
-    Weight  score = 0;
-};
+}
 
-const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weighting_2(
+const LocalSearchRowWeighting1Output stablesolver::stable::local_search_row_weighting_1(
         const Instance& instance,
         std::mt19937_64& generator,
-        const LocalSearchRowWeighting2Parameters& parameters)
+        const LocalSearchRowWeighting1Parameters& parameters)
 {
-    LocalSearchRowWeighting2Output output(instance);
+    LocalSearchRowWeighting1Output output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
-    algorithm_formatter.start("Row weighting local search 2");
+    algorithm_formatter.start("Row weighting local search 1");
 
     // Reduction.
     if (parameters.reduction_parameters.reduce) {
@@ -328,10 +794,36 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
                     const Instance& instance,
                     const Parameters& parameters)
                 {
-                    return local_search_row_weighting_2(
+                    return local_search_row_weighting_1(
                             instance,
                             generator,
-                            static_cast<const LocalSearchRowWeighting2Parameters&>(parameters));
+                            static_cast<const LocalSearchRowWeighting1Parameters&>(parameters));
+                },
+                instance,
+                parameters,
+                algorithm_formatter,
+                output);
+    }
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose) {
+        // The components may be solved concurrently, so each of them gets
+        // its own generator.
+        std::mutex generator_mutex;
+        return solve_components(
+                [&generator, &generator_mutex](
+                    const Instance& instance,
+                    const Parameters& parameters)
+                {
+                    std::mt19937_64 component_generator;
+                    {
+                        std::lock_guard<std::mutex> lock(generator_mutex);
+                        component_generator.seed(generator());
+                    }
+                    return local_search_row_weighting_1(
+                            instance,
+                            component_generator,
+                            static_cast<const LocalSearchRowWeighting1Parameters&>(parameters));
                 },
                 instance,
                 parameters,
@@ -341,11 +833,16 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
 
     algorithm_formatter.print_header();
 
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
     // Compute initial greedy solution.
     GreedyParameters greedy_parameters;
     greedy_parameters.verbosity_level = 0;
     greedy_parameters.timer = parameters.timer;
     greedy_parameters.reduction_parameters.reduce = false;
+    greedy_parameters.clique_cover_parameters.enable = false;
     Solution solution = greedy_gwmin(instance, greedy_parameters).solution;
     algorithm_formatter.update_solution(solution, "initial solution");
 
@@ -354,6 +851,76 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
         return output;
     }
 
+    LocalSearchRowWeightingShared shared;
+    shared.bound = clique_cover.bound();
+    shared.component_bounds = std::vector<std::atomic<Weight>>(instance.number_of_components());
+    for (ComponentId component_id = 0;
+            component_id < instance.number_of_components();
+            ++component_id) {
+        shared.component_bounds[component_id] = clique_cover.component_bound(component_id);
+    }
+    publish(shared, solution);
+    run_walkers(
+            parameters.number_of_threads,
+            generator,
+            [&instance, &parameters, &clique_cover, &solution, &shared, &algorithm_formatter, &output](
+                std::mt19937_64& generator,
+                Counter walker_id)
+            {
+                local_search_row_weighting_1_walker(
+                        instance,
+                        generator,
+                        parameters,
+                        (walker_id == 0)? &clique_cover: nullptr,
+                        solution,
+                        shared,
+                        algorithm_formatter,
+                        output,
+                        walker_id);
+            });
+    output.number_of_iterations = shared.number_of_iterations;
+
+    algorithm_formatter.end();
+    return output;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////// local_search_row_weighting_2 //////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+struct LocalSearchRowWeighting2Vertex
+{
+    Counter timestamp = -1;
+
+    Counter last_addition = -1;
+
+    Counter last_removal = -1;
+
+    Counter iterations = 0;
+
+    Weight  score = 0;
+};
+
+namespace
+{
+
+/**
+ * Run a walker of the row weighting local search 2.
+ */
+void local_search_row_weighting_2_walker(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeighting2Parameters& parameters,
+        CliqueCover* clique_cover,
+        const Solution& initial_solution,
+        LocalSearchRowWeightingShared& shared,
+        AlgorithmFormatter& algorithm_formatter,
+        LocalSearchRowWeighting2Output& output,
+        Counter walker_id)
+{
+    std::mt19937_64 clique_cover_generator;
+    Solution solution(initial_solution);
+
     // Initialize local search structures.
     std::vector<LocalSearchRowWeighting2Vertex> vertices(instance.number_of_vertices());
     std::vector<Penalty> solution_penalties(instance.number_of_edges(), 1);
@@ -367,56 +934,126 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
                     += solution_penalties[edge_id];
         }
     }
+    // Vertices outside of the solution, by score, and then by timestamp.
+    optimizationtools::IndexedBinaryHeap<std::pair<Weight, Counter>> heap(instance.number_of_vertices());
+    auto update_heap = [&solution, &vertices, &heap](VertexId vertex_id)
+    {
+        if (!solution.contains(vertex_id)) {
+            heap.update_key(
+                    vertex_id,
+                    {vertices[vertex_id].score, vertices[vertex_id].timestamp});
+        }
+    };
+    for (VertexId vertex_id = 0;
+            vertex_id < instance.number_of_vertices();
+            ++vertex_id) {
+        update_heap(vertex_id);
+    }
+
+    // Add or remove a vertex and update the scores. The timestamp of a
+    // removed vertex must be updated before it is pushed back in the heap.
+    auto add = [&instance, &solution, &vertices, &solution_penalties, &heap, &update_heap](
+            VertexId vertex_id)
+    {
+        heap.update_key(vertex_id, {std::numeric_limits<Weight>::lowest(), -1});
+        heap.pop();
+        solution.add(vertex_id);
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
+            update_heap(edge.vertex_id);
+        }
+    };
+    auto remove = [&instance, &solution, &vertices, &solution_penalties, &update_heap](
+            VertexId vertex_id)
+    {
+        solution.remove(vertex_id);
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            vertices[edge.vertex_id].score -= solution_penalties[edge.edge_id];
+            update_heap(edge.vertex_id);
+        }
+        update_heap(vertex_id);
+    };
+
     VertexId vertex_id_last_removed = -1;
     VertexId vertex_id_last_added = -1;
+    Weight best_weight = solution.weight();
 
     Counter iterations_without_improvment = 0;
-    for (output.number_of_iterations = 0;
+    Counter number_of_iterations = 0;
+    // Number of iterations already added to the shared number of iterations.
+    Counter number_of_iterations_reported = 0;
+    for (number_of_iterations = 0;
             !parameters.timer.needs_to_end();
-            ++output.number_of_iterations,
+            ++number_of_iterations,
             ++iterations_without_improvment) {
         // Check stop criteria.
         if (parameters.maximum_number_of_iterations != -1
-                && output.number_of_iterations >= parameters.maximum_number_of_iterations)
+                && number_of_iterations >= parameters.maximum_number_of_iterations)
             break;
         if (parameters.maximum_number_of_iterations_without_improvement != -1
                 && iterations_without_improvment >= parameters.maximum_number_of_iterations_without_improvement)
             break;
+
+        // Refine the clique cover bound, using at most 5% of the time.
+        if (clique_cover != nullptr
+                && number_of_iterations % 1024 == 0
+                && clique_cover->time() < 0.05 * parameters.timer.elapsed_time()
+                && clique_cover->improve(clique_cover_generator)) {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            algorithm_formatter.update_bound(clique_cover->bound(), "clique cover");
+            shared.bound = clique_cover->bound();
+        }
+        // Stop if the best solution is optimal.
+        if (shared.best_weight == shared.bound)
+            break;
+
+        // Restart from the shared best solution if the walker lags behind.
+        if (parameters.restart_interval > 0
+                && number_of_iterations > 0
+                && number_of_iterations % parameters.restart_interval == 0
+                && shared.best_weight > best_weight) {
+            std::shared_ptr<const LocalSearchRowWeightingElite> best = std::atomic_load(&shared.best);
+            std::vector<int8_t> contains(instance.number_of_vertices(), 0);
+            for (VertexId vertex_id: best->vertices)
+                contains[vertex_id] = 1;
+            for (VertexId vertex_id = 0;
+                    vertex_id < instance.number_of_vertices();
+                    ++vertex_id) {
+                if (solution.contains(vertex_id) && !contains[vertex_id])
+                    remove(vertex_id);
+            }
+            for (VertexId vertex_id: best->vertices)
+                if (!solution.contains(vertex_id))
+                    add(vertex_id);
+            best_weight = best->weight;
+            vertex_id_last_removed = -1;
+            vertex_id_last_added = -1;
+        }
         //std::cout << "it " << iterations << std::endl;
 
         while (solution.feasible()) {
 
             // Update best solution
-            if (optimizationtools::is_solution_strictly_better(
-                        objective_direction(),
-                        output.solution.feasible(),
-                        output.solution.objective_value(),
-                        solution.feasible(),
-                        solution.objective_value())) {
-                std::stringstream ss;
-                ss << "iteration " << output.number_of_iterations;
-                algorithm_formatter.update_solution(solution, ss.str());
+            if (solution.weight() > best_weight) {
+                best_weight = solution.weight();
+                if (publish(shared, solution)) {
+                    shared.number_of_iterations += number_of_iterations - number_of_iterations_reported;
+                    number_of_iterations_reported = number_of_iterations;
+                    std::lock_guard<std::mutex> lock(shared.mutex);
+                    output.number_of_iterations = shared.number_of_iterations;
+                    algorithm_formatter.update_solution(
+                            solution,
+                            walker_comment(parameters.number_of_threads, walker_id, number_of_iterations));
+                }
             }
 
             // Update statistics
             iterations_without_improvment = 0;
 
             // Find the best shift move.
-            VertexId vertex_id_best = -1;
-            Weight score_best = -1;
-            for (auto it_v = solution.vertices().out_begin();
-                    it_v != solution.vertices().out_end();
-                    ++it_v) {
-                if (vertex_id_best == -1
-                        || score_best > vertices[*it_v].score
-                        || (score_best == vertices[*it_v].score
-                            && vertices[vertex_id_best].timestamp > vertices[*it_v].timestamp)) {
-                    vertex_id_best = *it_v;
-                    score_best = vertices[*it_v].score;
-                }
-            }
+            VertexId vertex_id_best = heap.top().first;
             // Apply best move
-            solution.add(vertex_id_best);
+            add(vertex_id_best);
             //std::cout << "it " << iterations
                 //<< " vertex_id_best " << vertex_id_best
                 //<< " score " << score_best
@@ -424,13 +1061,9 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
                 //<< " v " << solution.number_of_vertices()
                 //<< " c " << solution.edges().number_of_edges(2)
                 //<< std::endl;
-            // Update scores.
-            for (const auto& edge: instance.vertex(vertex_id_best).edges)
-                if (solution.covers(edge.edge_id) >= 1)
-                    vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
             // Update vertices
-            vertices[vertex_id_best].timestamp = output.number_of_iterations;
-            vertices[vertex_id_best].last_addition = output.number_of_iterations;
+            vertices[vertex_id_best].timestamp = number_of_iterations;
+            vertices[vertex_id_best].last_addition = number_of_iterations;
             // Update tabu
             vertex_id_last_removed = -1;
             vertex_id_last_added   = -1;
@@ -444,49 +1077,42 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
             }
         }
 
-        // Find the cheapest vertex to add.
+        // Find the cheapest vertex to add. The last removed vertex is tabu,
+        // so it is taken out of the heap while looking for it.
         VertexId vertex_id_1_best = -1;
-        Weight score1_best = -1;
-        for (auto it_v = solution.vertices().out_begin();
-                it_v != solution.vertices().out_end();
-                ++it_v) {
-            VertexId vertex_id = *it_v;
-            if (vertex_id == vertex_id_last_removed)
-                continue;
-            if (vertex_id_1_best == -1
-                    || score1_best > vertices[vertex_id].score
-                    || (score1_best == vertices[vertex_id].score
-                        && vertices[vertex_id_1_best].timestamp
-                        > vertices[vertex_id].timestamp)) {
-                vertex_id_1_best = vertex_id;
-                score1_best = vertices[vertex_id].score;
-            }
+        if (!heap.empty() && heap.top().first == vertex_id_last_removed) {
+            heap.pop();
+            if (!heap.empty())
+                vertex_id_1_best = heap.top().first;
+            update_heap(vertex_id_last_removed);
+        } else if (!heap.empty()) {
+            vertex_id_1_best = heap.top().first;
         }
-        // Apply move
-        solution.add(vertex_id_1_best);
-        //std::cout << "it " << iterations
-            //<< " vertex_id_1_best " << vertex_id_1_best
-            //<< " score " << score1_best
-            //<< " p_prec " << tmp1
-            //<< " p " << solution.penalty()
-            //<< " v " << solution.number_of_vertices()
-            //<< " c " << solution.edges().number_of_edges(2)
-            //<< std::endl;
-        // Update scores.
-        for (const auto& edge: instance.vertex(vertex_id_1_best).edges)
-            if (solution.covers(edge.edge_id) >= 1)
-                vertices[edge.vertex_id].score += solution_penalties[edge.edge_id];
-        // Update sets
-        vertices[vertex_id_1_best].timestamp = output.number_of_iterations;
-        vertices[vertex_id_1_best].last_addition = output.number_of_iterations;
-        // Update tabu
-        vertex_id_last_added = vertex_id_1_best;
-        // Update penalties.
-        for (const auto& edge: instance.vertex(vertex_id_1_best).edges) {
-            if (solution.covers(edge.edge_id) >= 2) {
-                solution_penalties[edge.edge_id]++;
-                vertices[instance.edge(edge.edge_id).vertex_id_1].score++;
-                vertices[instance.edge(edge.edge_id).vertex_id_2].score++;
+        // On small components, all the vertices might already be in the
+        // solution.
+        if (vertex_id_1_best != -1) {
+            // Apply move
+            add(vertex_id_1_best);
+            //std::cout << "it " << iterations
+                //<< " vertex_id_1_best " << vertex_id_1_best
+                //<< " score " << score1_best
+                //<< " p_prec " << tmp1
+                //<< " p " << solution.penalty()
+                //<< " v " << solution.number_of_vertices()
+                //<< " c " << solution.edges().number_of_edges(2)
+                //<< std::endl;
+            // Update sets
+            vertices[vertex_id_1_best].timestamp = number_of_iterations;
+            vertices[vertex_id_1_best].last_addition = number_of_iterations;
+            // Update tabu
+            vertex_id_last_added = vertex_id_1_best;
+            // Update penalties.
+            for (const auto& edge: instance.vertex(vertex_id_1_best).edges) {
+                if (solution.covers(edge.edge_id) >= 2) {
+                    solution_penalties[edge.edge_id]++;
+                    vertices[instance.edge(edge.edge_id).vertex_id_1].score++;
+                    vertices[instance.edge(edge.edge_id).vertex_id_2].score++;
+                }
             }
         }
 
@@ -515,8 +1141,12 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
         }
         if (vertex_id_2_best == -1)
             vertex_id_2_best = vertex_id_1_best;
+        // Update sets
+        vertices[vertex_id_2_best].timestamp = number_of_iterations;
+        vertices[vertex_id_2_best].last_removal  = number_of_iterations;
+        vertices[vertex_id_2_best].iterations += (number_of_iterations - vertices[vertex_id_2_best].last_addition);
         // Apply move
-        solution.remove(vertex_id_2_best);
+        remove(vertex_id_2_best);
         //std::cout << "it " << iterations
             //<< " vertex_id_2_best " << vertex_id_2_best
             //<< " score " << score2_best
@@ -524,18 +1154,111 @@ const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weig
             //<< " v " << solution.number_of_vertices()
             //<< " c " << solution.edges().number_of_edges(2)
             //<< std::endl;
-        // Update scores.
-        for (const auto& edge: instance.vertex(vertex_id_2_best).edges)
-            if (solution.covers(edge.edge_id) <= 1)
-                vertices[edge.vertex_id].score -= solution_penalties[edge.edge_id];
-        // Update sets
-        vertices[vertex_id_2_best].timestamp = output.number_of_iterations;
-        vertices[vertex_id_2_best].last_removal  = output.number_of_iterations;
-        vertices[vertex_id_2_best].iterations += (output.number_of_iterations - vertices[vertex_id_2_best].last_addition);
         // Update tabu
         vertex_id_last_removed = vertex_id_2_best;
     }
 
+    shared.number_of_iterations += number_of_iterations - number_of_iterations_reported;
+}
+
+}
+
+const LocalSearchRowWeighting2Output stablesolver::stable::local_search_row_weighting_2(
+        const Instance& instance,
+        std::mt19937_64& generator,
+        const LocalSearchRowWeighting2Parameters& parameters)
+{
+    LocalSearchRowWeighting2Output output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Row weighting local search 2");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce) {
+        return solve_reduced_instance(
+                [&generator](
+                    const Instance& instance,
+                    const Parameters& parameters)
+                {
+                    return local_search_row_weighting_2(
+                            instance,
+                            generator,
+                            static_cast<const LocalSearchRowWeighting2Parameters&>(parameters));
+                },
+                instance,
+                parameters,
+                algorithm_formatter,
+                output);
+    }
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose) {
+        // The components may be solved concurrently, so each of them gets
+        // its own generator.
+        std::mutex generator_mutex;
+        return solve_components(
+                [&generator, &generator_mutex](
+                    const Instance& instance,
+                    const Parameters& parameters)
+                {
+                    std::mt19937_64 component_generator;
+                    {
+                        std::lock_guard<std::mutex> lock(generator_mutex);
+                        component_generator.seed(generator());
+                    }
+                    return local_search_row_weighting_2(
+                            instance,
+                            component_generator,
+                            static_cast<const LocalSearchRowWeighting2Parameters&>(parameters));
+                },
+                instance,
+                parameters,
+                algorithm_formatter,
+                output);
+    }
+
+    algorithm_formatter.print_header();
+
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    // Compute initial greedy solution.
+    GreedyParameters greedy_parameters;
+    greedy_parameters.verbosity_level = 0;
+    greedy_parameters.timer = parameters.timer;
+    greedy_parameters.reduction_parameters.reduce = false;
+    greedy_parameters.clique_cover_parameters.enable = false;
+    Solution solution = greedy_gwmin(instance, greedy_parameters).solution;
+    algorithm_formatter.update_solution(solution, "initial solution");
+
+    if (instance.number_of_vertices() == 0) {
+        algorithm_formatter.end();
+        return output;
+    }
+
+    LocalSearchRowWeightingShared shared;
+    shared.bound = clique_cover.bound();
+    publish(shared, solution);
+    run_walkers(
+            parameters.number_of_threads,
+            generator,
+            [&instance, &parameters, &clique_cover, &solution, &shared, &algorithm_formatter, &output](
+                std::mt19937_64& generator,
+                Counter walker_id)
+            {
+                local_search_row_weighting_2_walker(
+                        instance,
+                        generator,
+                        parameters,
+                        (walker_id == 0)? &clique_cover: nullptr,
+                        solution,
+                        shared,
+                        algorithm_formatter,
+                        output,
+                        walker_id);
+            });
+    output.number_of_iterations = shared.number_of_iterations;
+
     algorithm_formatter.end();
     return output;
 }
@@ -391,6 +391,24 @@ const Output milp(
                 output);
     }
 
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose) {
+        return solve_components(
+                [model_id](
+                    const Instance& instance,
+                    const Parameters& parameters)
+                {
+                    return milp(
+                            instance,
+                            static_cast<const MilpParameters&>(parameters),
+                            model_id);
+                },
+                instance,
+                parameters,
+                algorithm_formatter,
+                output);
+    }
+
     algorithm_formatter.print_header();
 
     mathoptsolverscmake::MathOptModel milp_model =
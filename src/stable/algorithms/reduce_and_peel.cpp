@@ -0,0 +1,267 @@
+#include "stablesolver/stable/algorithms/reduce_and_peel.hpp"
+
+#include "stablesolver/stable/algorithm_formatter.hpp"
+
+using namespace stablesolver::stable;
+
+namespace
+{
+
+/**
+ * Class that stores the vertices in doubly linked lists by residual degree.
+ *
+ * Residual degrees only decrease, so the highest degree is found in
+ * amortized constant time.
+ */
+class DegreeBuckets
+{
+
+public:
+
+    /** Constructor. */
+    DegreeBuckets(
+            const std::vector<VertexId>& degrees,
+            VertexId highest_degree):
+        heads_(highest_degree + 1, -1),
+        nexts_(degrees.size(), -1),
+        previous_(degrees.size(), -1),
+        degrees_(degrees),
+        highest_degree_(highest_degree)
+    {
+        for (VertexId vertex_id = 0;
+                vertex_id < (VertexId)degrees.size();
+                ++vertex_id) {
+            insert(vertex_id);
+        }
+    }
+
+    /** Remove a vertex. */
+    void remove(VertexId vertex_id)
+    {
+        if (previous_[vertex_id] != -1) {
+            nexts_[previous_[vertex_id]] = nexts_[vertex_id];
+        } else {
+            heads_[degrees_[vertex_id]] = nexts_[vertex_id];
+        }
+        if (nexts_[vertex_id] != -1)
+            previous_[nexts_[vertex_id]] = previous_[vertex_id];
+    }
+
+    /** Update the residual degree of a vertex. */
+    void update(
+            VertexId vertex_id,
+            VertexId degree)
+    {
+        remove(vertex_id);
+        degrees_[vertex_id] = degree;
+        insert(vertex_id);
+    }
+
+    /** Get a vertex of highest residual degree; -1 if there is none. */
+    VertexId highest_degree_vertex()
+    {
+        while (highest_degree_ >= 0 && heads_[highest_degree_] == -1)
+            highest_degree_--;
+        return (highest_degree_ >= 0)? heads_[highest_degree_]: -1;
+    }
+
+private:
+
+    /** Insert a vertex in the bucket of its residual degree. */
+    void insert(VertexId vertex_id)
+    {
+        VertexId degree = degrees_[vertex_id];
+        previous_[vertex_id] = -1;
+        nexts_[vertex_id] = heads_[degree];
+        if (heads_[degree] != -1)
+            previous_[heads_[degree]] = vertex_id;
+        heads_[degree] = vertex_id;
+    }
+
+    /** For each degree, first vertex of its bucket. */
+    std::vector<VertexId> heads_;
+
+    /** For each vertex, next vertex in its bucket. */
+    std::vector<VertexId> nexts_;
+
+    /** For each vertex, previous vertex in its bucket. */
+    std::vector<VertexId> previous_;
+
+    /** For each vertex, its residual degree. */
+    std::vector<VertexId> degrees_;
+
+    /** Upper bound on the highest residual degree. */
+    VertexId highest_degree_;
+
+};
+
+/**
+ * Structure that stores a vertex folded into its unique neighbor.
+ *
+ * The vertex is in the solution iff its neighbor is not.
+ */
+struct ReduceAndPeelFold
+{
+    /** Folded vertex. */
+    VertexId vertex_id;
+
+    /** Neighbor. */
+    VertexId neighbor_id;
+};
+
+}
+
+const ReduceAndPeelOutput stablesolver::stable::reduce_and_peel(
+        const Instance& instance,
+        const ReduceAndPeelParameters& parameters)
+{
+    ReduceAndPeelOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Reduce and peel");
+
+    // Reduction.
+    if (parameters.reduction_parameters.reduce)
+        return solve_reduced_instance(reduce_and_peel, instance, parameters, algorithm_formatter, output);
+
+    // Component decomposition.
+    if (parameters.component_decomposition_parameters.decompose)
+        return solve_components(reduce_and_peel, instance, parameters, algorithm_formatter, output);
+
+    algorithm_formatter.print_header();
+
+    // Clique cover bound.
+    CliqueCover clique_cover(instance, parameters.clique_cover_parameters);
+    algorithm_formatter.update_bound(clique_cover.bound(), "clique cover");
+
+    VertexId number_of_vertices = instance.number_of_vertices();
+    std::vector<Weight> weights(number_of_vertices);
+    std::vector<VertexId> degrees(number_of_vertices);
+    VertexId highest_degree = 0;
+    std::vector<VertexId> queue;
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id) {
+        weights[vertex_id] = instance.vertex(vertex_id).weight;
+        degrees[vertex_id] = instance.degree(vertex_id);
+        highest_degree = (std::max)(highest_degree, degrees[vertex_id]);
+        if (degrees[vertex_id] <= 2)
+            queue.push_back(vertex_id);
+    }
+    DegreeBuckets buckets(degrees, highest_degree);
+    std::vector<int8_t> alive(number_of_vertices, 1);
+    std::vector<int8_t> in_solution(number_of_vertices, 0);
+    std::vector<ReduceAndPeelFold> folds;
+    std::vector<VertexId> peeled_vertices;
+    // Weight of the vertices fixed by the reductions.
+    Weight offset = 0;
+    // Weight of the peeled vertices at the time they are peeled.
+    Weight peeled_weight = 0;
+
+    // Remove a vertex from the graph and update the residual degrees of its
+    // neighbors.
+    auto remove = [&instance, &alive, &degrees, &buckets, &queue](VertexId vertex_id)
+    {
+        alive[vertex_id] = 0;
+        buckets.remove(vertex_id);
+        for (const auto& edge: instance.vertex(vertex_id).edges) {
+            if (!alive[edge.vertex_id])
+                continue;
+            degrees[edge.vertex_id]--;
+            buckets.update(edge.vertex_id, degrees[edge.vertex_id]);
+            if (degrees[edge.vertex_id] <= 2)
+                queue.push_back(edge.vertex_id);
+        }
+    };
+
+    // Add a vertex to the solution and remove its closed neighborhood.
+    auto take = [&instance, &alive, &in_solution, &weights, &offset, &remove](VertexId vertex_id)
+    {
+        in_solution[vertex_id] = 1;
+        offset += weights[vertex_id];
+        remove(vertex_id);
+        for (const auto& edge: instance.vertex(vertex_id).edges)
+            if (alive[edge.vertex_id])
+                remove(edge.vertex_id);
+    };
+
+    for (;;) {
+        // Apply the reduction rules to the vertices of degree at most 2.
+        while (!queue.empty()) {
+            VertexId vertex_id = queue.back();
+            queue.pop_back();
+            if (!alive[vertex_id] || degrees[vertex_id] > 2)
+                continue;
+
+            // Get the distinct neighbors of the vertex.
+            VertexId neighbors[2];
+            VertexPos number_of_neighbors = 0;
+            Weight neighbors_weight = 0;
+            Weight neighbors_highest_weight = 0;
+            for (const auto& edge: instance.vertex(vertex_id).edges) {
+                if (!alive[edge.vertex_id])
+                    continue;
+                if (number_of_neighbors == 1 && neighbors[0] == edge.vertex_id)
+                    continue;
+                neighbors[number_of_neighbors] = edge.vertex_id;
+                number_of_neighbors++;
+                neighbors_weight += weights[edge.vertex_id];
+                neighbors_highest_weight = (std::max)(
+                        neighbors_highest_weight,
+                        weights[edge.vertex_id]);
+            }
+
+            if (weights[vertex_id] >= neighbors_weight) {
+                take(vertex_id);
+                output.number_of_reduced_vertices++;
+            } else if (number_of_neighbors == 2
+                    && weights[vertex_id] >= neighbors_highest_weight
+                    && instance.has_edge(neighbors[0], neighbors[1])) {
+                take(vertex_id);
+                output.number_of_reduced_vertices++;
+            } else if (number_of_neighbors == 1) {
+                weights[neighbors[0]] -= weights[vertex_id];
+                offset += weights[vertex_id];
+                folds.push_back({vertex_id, neighbors[0]});
+                remove(vertex_id);
+                output.number_of_reduced_vertices++;
+            }
+        }
+
+        // Peel a vertex of highest residual degree.
+        VertexId vertex_id = buckets.highest_degree_vertex();
+        if (vertex_id == -1)
+            break;
+        peeled_vertices.push_back(vertex_id);
+        peeled_weight += weights[vertex_id];
+        remove(vertex_id);
+    }
+
+    // Unfold the folded vertices.
+    for (auto it = folds.rbegin(); it != folds.rend(); ++it)
+        if (!in_solution[it->neighbor_id])
+            in_solution[it->vertex_id] = 1;
+
+    // The solution is optimal for the graph without the peeled vertices.
+    algorithm_formatter.update_bound(offset + peeled_weight, "reduce and peel");
+
+    // Add the peeled vertices which have no neighbor in the solution.
+    for (auto it = peeled_vertices.rbegin(); it != peeled_vertices.rend(); ++it) {
+        bool ok = true;
+        for (const auto& edge: instance.vertex(*it).edges) {
+            if (in_solution[edge.vertex_id]) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok)
+            in_solution[*it] = 1;
+    }
+
+    Solution solution(instance);
+    for (VertexId vertex_id = 0; vertex_id < number_of_vertices; ++vertex_id)
+        if (in_solution[vertex_id])
+            solution.add(vertex_id);
+    output.number_of_peeled_vertices = peeled_vertices.size();
+    algorithm_formatter.update_solution(solution, "");
+
+    algorithm_formatter.end();
+    return output;
+}
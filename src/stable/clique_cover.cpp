@@ -0,0 +1,286 @@
+#include "stablesolver/stable/clique_cover.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace stablesolver::stable;
+
+template <typename Function>
+void CliqueCover::for_each_component(
+        const Function& function)
+{
+    ComponentId number_of_components = instance_->number_of_components();
+    Counter number_of_threads = (std::max)((Counter)1, (std::min)(
+                parameters_.number_of_threads,
+                (Counter)number_of_components));
+
+    std::atomic<ComponentId> next_component_id(0);
+    std::exception_ptr exception = nullptr;
+    std::mutex exception_mutex;
+    auto worker = [
+        &function,
+        &next_component_id,
+        &exception,
+        &exception_mutex,
+        number_of_components]()
+    {
+        try {
+            for (;;) {
+                ComponentId component_id = next_component_id++;
+                if (component_id >= number_of_components)
+                    break;
+                function(component_id);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(exception_mutex);
+            if (!exception)
+                exception = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (Counter thread_id = 1; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+CliqueCover::CliqueCover(
+        const Instance& instance,
+        const CliqueCoverParameters& parameters):
+    instance_(&instance),
+    parameters_(parameters),
+    bound_(instance.total_weight())
+{
+    if (!parameters.enable)
+        return;
+    auto start = std::chrono::steady_clock::now();
+
+    components_ = std::vector<ComponentCliqueCover>(instance.number_of_components());
+    vertex_cliques_ = std::vector<VertexPos>(instance.number_of_vertices(), -1);
+    for_each_component([this](ComponentId component_id)
+            {
+                // Consider the vertices by non-increasing weight, then by
+                // non-increasing degree.
+                std::vector<VertexId> vertices = instance_->component(component_id).vertices;
+                std::sort(
+                        vertices.begin(),
+                        vertices.end(),
+                        [this](VertexId vertex_id_1, VertexId vertex_id_2)
+                        {
+                            const Vertex& vertex_1 = instance_->vertex(vertex_id_1);
+                            const Vertex& vertex_2 = instance_->vertex(vertex_id_2);
+                            if (vertex_1.weight != vertex_2.weight)
+                                return vertex_1.weight > vertex_2.weight;
+                            return vertex_1.edges.size() > vertex_2.edges.size();
+                        });
+                components_[component_id] = partition(vertices, nullptr);
+            });
+
+    bound_ = 0;
+    for (const ComponentCliqueCover& component: components_)
+        bound_ += component.bound;
+
+    auto end = std::chrono::steady_clock::now();
+    time_ += std::chrono::duration<double>(end - start).count();
+}
+
+CliqueCover::ComponentCliqueCover CliqueCover::partition(
+        const std::vector<VertexId>& vertices,
+        std::mt19937_64* generator)
+{
+    for (VertexId vertex_id: vertices)
+        vertex_cliques_[vertex_id] = -1;
+
+    std::vector<std::vector<VertexId>> cliques;
+    std::vector<Weight> cliques_weights;
+    // For each clique, number of neighbors of the current vertex in it.
+    std::vector<VertexPos> cliques_number_of_neighbors(vertices.size(), 0);
+    std::vector<VertexPos> neighbor_cliques;
+    for (VertexId vertex_id: vertices) {
+        const Vertex& vertex = instance_->vertex(vertex_id);
+
+        // Count the neighbors of the vertex in each clique. Adjacency lists
+        // are sorted, so duplicate edges are consecutive.
+        neighbor_cliques.clear();
+        VertexId vertex_id_prev = -1;
+        for (const VertexEdge& edge: vertex.edges) {
+            if (edge.vertex_id == vertex_id_prev)
+                continue;
+            vertex_id_prev = edge.vertex_id;
+            VertexPos clique_id = vertex_cliques_[edge.vertex_id];
+            if (clique_id == -1)
+                continue;
+            if (cliques_number_of_neighbors[clique_id] == 0)
+                neighbor_cliques.push_back(clique_id);
+            cliques_number_of_neighbors[clique_id]++;
+        }
+
+        // Find the clique in which adding the vertex increases the bound the
+        // least.
+        VertexPos clique_id_best = -1;
+        Weight increase_best = vertex.weight;
+        Counter number_of_ties = 0;
+        for (VertexPos clique_id: neighbor_cliques) {
+            VertexPos number_of_neighbors = cliques_number_of_neighbors[clique_id];
+            cliques_number_of_neighbors[clique_id] = 0;
+            if (number_of_neighbors != (VertexPos)cliques[clique_id].size())
+                continue;
+            Weight increase = (std::max)((Weight)0, vertex.weight - cliques_weights[clique_id]);
+            if (clique_id_best == -1 || increase < increase_best) {
+                clique_id_best = clique_id;
+                increase_best = increase;
+                number_of_ties = 1;
+            } else if (increase == increase_best && generator != nullptr) {
+                number_of_ties++;
+                std::uniform_int_distribution<Counter> d(0, number_of_ties - 1);
+                if (d(*generator) == 0)
+                    clique_id_best = clique_id;
+            }
+        }
+
+        if (clique_id_best == -1) {
+            clique_id_best = cliques.size();
+            cliques.push_back({});
+            cliques_weights.push_back(0);
+        }
+        cliques[clique_id_best].push_back(vertex_id);
+        cliques_weights[clique_id_best] = (std::max)(
+                cliques_weights[clique_id_best],
+                vertex.weight);
+        vertex_cliques_[vertex_id] = clique_id_best;
+    }
+
+    ComponentCliqueCover component;
+    component.vertices.reserve(vertices.size());
+    component.clique_starts.reserve(cliques.size() + 1);
+    for (VertexPos clique_id = 0;
+            clique_id < (VertexPos)cliques.size();
+            ++clique_id) {
+        component.vertices.insert(
+                component.vertices.end(),
+                cliques[clique_id].begin(),
+                cliques[clique_id].end());
+        component.clique_starts.push_back(component.vertices.size());
+        component.bound += cliques_weights[clique_id];
+    }
+    return component;
+}
+
+std::vector<std::vector<VertexId>> CliqueCover::cliques() const
+{
+    std::vector<std::vector<VertexId>> cliques;
+    for (const ComponentCliqueCover& component: components_) {
+        for (VertexPos clique_id = 0;
+                clique_id + 1 < (VertexPos)component.clique_starts.size();
+                ++clique_id) {
+            cliques.push_back(std::vector<VertexId>(
+                        component.vertices.begin() + component.clique_starts[clique_id],
+                        component.vertices.begin() + component.clique_starts[clique_id + 1]));
+        }
+    }
+    return cliques;
+}
+
+Weight CliqueCover::component_bound(ComponentId component_id) const
+{
+    if (!parameters_.enable) {
+        Weight bound = 0;
+        for (VertexId vertex_id: instance_->component(component_id).vertices)
+            bound += instance_->vertex(vertex_id).weight;
+        return bound;
+    }
+    return components_[component_id].bound;
+}
+
+bool CliqueCover::improve(
+        std::mt19937_64& generator)
+{
+    if (!parameters_.enable)
+        return false;
+    auto start = std::chrono::steady_clock::now();
+
+    // Draw the seeds beforehand so that the result doesn't depend on the
+    // number of threads.
+    std::vector<Seed> seeds(instance_->number_of_components());
+    for (Seed& seed: seeds)
+        seed = generator();
+
+    for_each_component([this, &seeds](ComponentId component_id)
+            {
+                ComponentCliqueCover& component = components_[component_id];
+                // A single clique is optimal.
+                VertexPos number_of_cliques = component.clique_starts.size() - 1;
+                if (number_of_cliques <= 1)
+                    return;
+                std::mt19937_64 component_generator(seeds[component_id]);
+
+                // Consider the cliques by non-increasing maximum weight, ties
+                // broken randomly, and the vertices of each clique by
+                // non-increasing weight.
+                std::vector<std::pair<Weight, VertexPos>> cliques(number_of_cliques);
+                for (VertexPos clique_id = 0;
+                        clique_id < number_of_cliques;
+                        ++clique_id) {
+                    Weight weight = 0;
+                    for (VertexPos pos = component.clique_starts[clique_id];
+                            pos < component.clique_starts[clique_id + 1];
+                            ++pos) {
+                        weight = (std::max)(
+                                weight,
+                                instance_->vertex(component.vertices[pos]).weight);
+                    }
+                    cliques[clique_id] = {weight, clique_id};
+                }
+                std::shuffle(cliques.begin(), cliques.end(), component_generator);
+                std::stable_sort(
+                        cliques.begin(),
+                        cliques.end(),
+                        [](
+                            const std::pair<Weight, VertexPos>& clique_1,
+                            const std::pair<Weight, VertexPos>& clique_2)
+                        {
+                            return clique_1.first > clique_2.first;
+                        });
+                std::vector<VertexId> vertices;
+                vertices.reserve(component.vertices.size());
+                for (const auto& clique: cliques) {
+                    auto first = vertices.end() - vertices.begin();
+                    vertices.insert(
+                            vertices.end(),
+                            component.vertices.begin() + component.clique_starts[clique.second],
+                            component.vertices.begin() + component.clique_starts[clique.second + 1]);
+                    std::sort(
+                            vertices.begin() + first,
+                            vertices.end(),
+                            [this](VertexId vertex_id_1, VertexId vertex_id_2)
+                            {
+                                return instance_->vertex(vertex_id_1).weight
+                                    > instance_->vertex(vertex_id_2).weight;
+                            });
+                }
+
+                ComponentCliqueCover new_component = partition(
+                        vertices,
+                        &component_generator);
+                if (new_component.bound < component.bound)
+                    component = std::move(new_component);
+            });
+
+    Weight bound = 0;
+    for (const ComponentCliqueCover& component: components_)
+        bound += component.bound;
+    bool improved = (bound < bound_);
+    bound_ = bound;
+
+    auto end = std::chrono::steady_clock::now();
+    time_ += std::chrono::duration<double>(end - start).count();
+    return improved;
+}
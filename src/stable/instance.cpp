@@ -3,6 +3,7 @@
 
 #include "optimizationtools/containers/indexed_set.hpp"
 
+#include <algorithm>
 #include <iomanip>
 #include <ostream>
 
@@ -30,6 +31,129 @@ const Instance Instance::complementary()
     return instance_builder.build();
 }
 
+namespace
+{
+
+/**
+ * Ratio between the sizes of two adjacency lists above which the elements of
+ * the smaller list are searched in the larger one instead of merging them.
+ */
+const VertexPos search_ratio = 16;
+
+/**
+ * Return the first position in 'edges' between 'first' and 'last' with a
+ * neighbor greater or equal to 'vertex_id'.
+ *
+ * Galloping search: the size of the searched range is doubled until it
+ * contains the result, which makes a sequence of increasing searches cost
+ * O(k log(n / k)).
+ */
+inline const VertexEdge* gallop(
+        const VertexEdge* first,
+        const VertexEdge* last,
+        VertexId vertex_id)
+{
+    VertexPos step = 1;
+    while (first + step < last && (first + step)->vertex_id < vertex_id) {
+        first += step;
+        step *= 2;
+    }
+    return std::lower_bound(
+            first,
+            (first + step < last)? first + step + 1: last,
+            vertex_id,
+            [](const VertexEdge& edge, VertexId vertex_id)
+            {
+                return edge.vertex_id < vertex_id;
+            });
+}
+
+}
+
+bool Instance::has_edge(
+        VertexId vertex_id_1,
+        VertexId vertex_id_2) const
+{
+    // Search in the smallest adjacency list.
+    if (degree(vertex_id_1) > degree(vertex_id_2))
+        std::swap(vertex_id_1, vertex_id_2);
+    const std::vector<VertexEdge>& edges = vertex(vertex_id_1).edges;
+    const VertexEdge* last = edges.data() + edges.size();
+    const VertexEdge* it = gallop(edges.data(), last, vertex_id_2);
+    return it != last && it->vertex_id == vertex_id_2;
+}
+
+bool Instance::is_neighborhood_included(
+        VertexId vertex_id_1,
+        VertexId vertex_id_2) const
+{
+    const std::vector<VertexEdge>& edges_1 = vertex(vertex_id_1).edges;
+    const std::vector<VertexEdge>& edges_2 = vertex(vertex_id_2).edges;
+    const VertexEdge* it_1 = edges_1.data();
+    const VertexEdge* last_1 = it_1 + edges_1.size();
+    const VertexEdge* it_2 = edges_2.data();
+    const VertexEdge* last_2 = it_2 + edges_2.size();
+
+    if ((VertexPos)edges_2.size() > search_ratio * (VertexPos)edges_1.size()) {
+        for (; it_1 != last_1; ++it_1) {
+            if (it_1->vertex_id == vertex_id_2)
+                continue;
+            it_2 = gallop(it_2, last_2, it_1->vertex_id);
+            if (it_2 == last_2 || it_2->vertex_id != it_1->vertex_id)
+                return false;
+        }
+        return true;
+    }
+
+    while (it_1 != last_1 && it_2 != last_2) {
+        VertexId v1 = it_1->vertex_id;
+        VertexId v2 = it_2->vertex_id;
+        if (v1 < v2 && v1 != vertex_id_2)
+            return false;
+        // Advance without branching on the comparison.
+        it_1 += (v1 <= v2 || v1 == vertex_id_2);
+        it_2 += (v1 > v2);
+    }
+    for (; it_1 != last_1; ++it_1)
+        if (it_1->vertex_id != vertex_id_2)
+            return false;
+    return true;
+}
+
+VertexPos Instance::number_of_common_neighbors(
+        VertexId vertex_id_1,
+        VertexId vertex_id_2) const
+{
+    if (degree(vertex_id_1) > degree(vertex_id_2))
+        std::swap(vertex_id_1, vertex_id_2);
+    const std::vector<VertexEdge>& edges_1 = vertex(vertex_id_1).edges;
+    const std::vector<VertexEdge>& edges_2 = vertex(vertex_id_2).edges;
+    const VertexEdge* it_1 = edges_1.data();
+    const VertexEdge* last_1 = it_1 + edges_1.size();
+    const VertexEdge* it_2 = edges_2.data();
+    const VertexEdge* last_2 = it_2 + edges_2.size();
+
+    VertexPos number_of_common_neighbors = 0;
+    if ((VertexPos)edges_2.size() > search_ratio * (VertexPos)edges_1.size()) {
+        for (; it_1 != last_1 && it_2 != last_2; ++it_1) {
+            it_2 = gallop(it_2, last_2, it_1->vertex_id);
+            number_of_common_neighbors += (
+                    it_2 != last_2
+                    && it_2->vertex_id == it_1->vertex_id);
+        }
+        return number_of_common_neighbors;
+    }
+
+    while (it_1 != last_1 && it_2 != last_2) {
+        VertexId v1 = it_1->vertex_id;
+        VertexId v2 = it_2->vertex_id;
+        number_of_common_neighbors += (v1 == v2);
+        it_1 += (v1 <= v2);
+        it_2 += (v1 >= v2);
+    }
+    return number_of_common_neighbors;
+}
+
 std::ostream& Instance::format(
         std::ostream& os,
         int verbosity_level) const
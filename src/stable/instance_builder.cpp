@@ -3,6 +3,7 @@
 #include "optimizationtools/utils/utils.hpp"
 
 #include <fstream>
+#include <algorithm>
 
 using namespace stablesolver::stable;
 
@@ -105,8 +106,6 @@ void InstanceBuilder::read(
         throw std::invalid_argument(
                 "Unknown instance format \"" + format + "\".");
     }
-
-    compute_components();
 }
 
 void InstanceBuilder::read_dimacs1992(std::ifstream& file)
@@ -243,6 +242,22 @@ void InstanceBuilder::read_snap(std::ifstream& file)
 //////////////////////////////////// Build /////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+void InstanceBuilder::sort_adjacency_lists()
+{
+    for (VertexId vertex_id = 0;
+            vertex_id < instance_.number_of_vertices();
+            ++vertex_id) {
+        std::vector<VertexEdge>& edges = instance_.vertices_[vertex_id].edges;
+        std::sort(
+                edges.begin(),
+                edges.end(),
+                [](const VertexEdge& edge_1, const VertexEdge& edge_2)
+                {
+                    return edge_1.vertex_id < edge_2.vertex_id;
+                });
+    }
+}
+
 void InstanceBuilder::compute_highest_degree()
 {
     instance_.highest_degree_ = 0;
@@ -308,6 +323,7 @@ void InstanceBuilder::compute_components()
 
 Instance InstanceBuilder::build()
 {
+    sort_adjacency_lists();
     compute_highest_degree();
     compute_total_weight();
     compute_components();
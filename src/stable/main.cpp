@@ -2,10 +2,13 @@
 
 #include "stablesolver/stable/solution.hpp"
 #include "stablesolver/stable/algorithms/greedy.hpp"
+#include "stablesolver/stable/algorithms/reduce_and_peel.hpp"
 #include "stablesolver/stable/algorithms/milp.hpp"
 #include "stablesolver/stable/algorithms/local_search.hpp"
 #include "stablesolver/stable/algorithms/local_search_row_weighting.hpp"
+#include "stablesolver/stable/algorithms/iterated_local_search.hpp"
 #include "stablesolver/stable/algorithms/large_neighborhood_search.hpp"
+#include "stablesolver/stable/algorithms/lagrangian_relaxation.hpp"
 
 #include <boost/program_options.hpp>
 
@@ -26,6 +29,17 @@ void read_args(
     if (vm.count("log"))
         parameters.log_path = vm["log"].as<std::string>();
     parameters.log_to_stderr = vm.count("log-to-stderr");
+    if (vm.count("reduction-time-limit"))
+        parameters.reduction_parameters.time_limit = vm["reduction-time-limit"].as<double>();
+    if (vm.count("reduction-cache"))
+        parameters.reduction_parameters.cache_directory = vm["reduction-cache"].as<std::string>();
+    parameters.component_decomposition_parameters.decompose = vm.count("component-decomposition");
+    if (vm.count("component-decomposition-threads"))
+        parameters.component_decomposition_parameters.number_of_threads = vm["component-decomposition-threads"].as<int>();
+    if (vm.count("clique-cover"))
+        parameters.clique_cover_parameters.enable = vm["clique-cover"].as<bool>();
+    if (vm.count("clique-cover-threads"))
+        parameters.clique_cover_parameters.number_of_threads = vm["clique-cover-threads"].as<int>();
     bool only_write_at_the_end = vm.count("only-write-at-the-end");
     if (!only_write_at_the_end) {
         std::string certificate_path = vm["certificate"].as<std::string>();
@@ -67,6 +81,26 @@ Output run(
         GreedyParameters parameters;
         read_args(parameters, vm);
         return greedy_strong(instance, parameters);
+    } else if (algorithm == "greedy-parallel") {
+        GreedyParallelParameters parameters;
+        read_args(parameters, vm);
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        parameters.seed = vm["seed"].as<Seed>();
+        return greedy_parallel(instance, parameters);
+    } else if (algorithm == "greedy-multistart") {
+        GreedyMultistartParameters parameters;
+        read_args(parameters, vm);
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        if (vm.count("number-of-restarts"))
+            parameters.number_of_restarts = vm["number-of-restarts"].as<int>();
+        parameters.seed = vm["seed"].as<Seed>();
+        return greedy_multistart(instance, parameters);
+    } else if (algorithm == "reduce-and-peel") {
+        ReduceAndPeelParameters parameters;
+        read_args(parameters, vm);
+        return reduce_and_peel(instance, parameters);
     } else if (algorithm == "milp-1") {
         MilpParameters parameters;
         read_args(parameters, vm);
@@ -86,6 +120,10 @@ Output run(
             parameters.maximum_number_of_iterations = vm["maximum-number-of-iterations"].as<int>();
         if (vm.count("maximum-number-of-iterations-without-improvement"))
             parameters.maximum_number_of_iterations_without_improvement = vm["maximum-number-of-iterations-without-improvement"].as<int>();
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        if (vm.count("restart-interval"))
+            parameters.restart_interval = vm["restart-interval"].as<int>();
         return local_search_row_weighting_1(instance, generator, parameters);
     } else if (algorithm == "local-search-row-weighting-2") {
         LocalSearchRowWeighting2Parameters parameters;
@@ -94,19 +132,64 @@ Output run(
             parameters.maximum_number_of_iterations = vm["maximum-number-of-iterations"].as<int>();
         if (vm.count("maximum-number-of-iterations-without-improvement"))
             parameters.maximum_number_of_iterations_without_improvement = vm["maximum-number-of-iterations-without-improvement"].as<int>();
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        if (vm.count("restart-interval"))
+            parameters.restart_interval = vm["restart-interval"].as<int>();
         return local_search_row_weighting_2(instance, generator, parameters);
+    } else if (algorithm == "iterated-local-search") {
+        IteratedLocalSearchParameters parameters;
+        read_args(parameters, vm);
+        if (vm.count("maximum-number-of-iterations"))
+            parameters.maximum_number_of_iterations = vm["maximum-number-of-iterations"].as<int>();
+        if (vm.count("maximum-number-of-iterations-without-improvement"))
+            parameters.maximum_number_of_iterations_without_improvement = vm["maximum-number-of-iterations-without-improvement"].as<int>();
+        return iterated_local_search(instance, generator, parameters);
     } else if (algorithm == "local-search") {
         LocalSearchParameters parameters;
         read_args(parameters, vm);
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        if (vm.count("number-of-islands"))
+            parameters.number_of_islands = vm["number-of-islands"].as<int>();
+        if (vm.count("migration-interval"))
+            parameters.migration_interval = vm["migration-interval"].as<double>();
+        if (vm.count("migration-topology")) {
+            std::string migration_topology = vm["migration-topology"].as<std::string>();
+            if (migration_topology == "ring") {
+                parameters.migration_topology = MigrationTopology::Ring;
+            } else if (migration_topology == "complete") {
+                parameters.migration_topology = MigrationTopology::Complete;
+            } else {
+                throw std::invalid_argument(
+                        "Unknown migration topology \"" + migration_topology + "\".");
+            }
+        }
+        if (vm.count("number-of-perturbations"))
+            parameters.number_of_perturbations = vm["number-of-perturbations"].as<int>();
+        parameters.seed = vm["seed"].as<Seed>();
         return local_search(instance, parameters);
     } else if (algorithm == "large-neighborhood-search") {
         LargeNeighborhoodSearchParameters parameters;
         read_args(parameters, vm);
+        if (vm.count("number-of-threads"))
+            parameters.number_of_threads = vm["number-of-threads"].as<int>();
+        if (vm.count("restart-interval"))
+            parameters.restart_interval = vm["restart-interval"].as<int>();
         if (vm.count("maximum-number-of-iterations"))
             parameters.maximum_number_of_iterations = vm["maximum-number-of-iterations"].as<int>();
         if (vm.count("maximum-number-of-iterations-without-improvement"))
             parameters.maximum_number_of_iterations_without_improvement = vm["maximum-number-of-iterations-without-improvement"].as<int>();
+        parameters.lagrangian_relaxation_bound = vm.count("lagrangian-relaxation-bound");
+        parameters.deterministic = vm.count("deterministic");
+        parameters.seed = vm["seed"].as<Seed>();
         return large_neighborhood_search(instance, parameters);
+    } else if (algorithm == "lagrangian-relaxation") {
+        LagrangianRelaxationParameters parameters;
+        read_args(parameters, vm);
+        if (vm.count("maximum-number-of-iterations"))
+            parameters.maximum_number_of_iterations = vm["maximum-number-of-iterations"].as<int>();
+        return lagrangian_relaxation(instance, parameters);
 
     } else {
         throw std::invalid_argument(
@@ -134,10 +217,25 @@ int main(int argc, char *argv[])
         ("only-write-at-the-end,e", "only write output and certificate files at the end")
         ("log,l", po::value<std::string>(), "set log file")
         ("log-to-stderr", "write log to stderr")
+        ("reduction-time-limit,", po::value<double>(), "set the time limit of the reduction in seconds")
+        ("reduction-cache,", po::value<std::string>(), "set the directory where reductions are cached")
+        ("component-decomposition,", "solve the connected components independently")
+        ("component-decomposition-threads,", po::value<int>(), "set the number of threads used to solve the components")
+        ("clique-cover,", po::value<bool>(), "enable or disable the clique cover bound")
+        ("clique-cover-threads,", po::value<int>(), "set the number of threads used to compute the clique cover bound")
 
         ("solver,", po::value<mathoptsolverscmake::SolverName>(), "set solver")
+        ("number-of-threads,", po::value<int>(), "set the number of threads")
+        ("number-of-restarts,", po::value<int>(), "set the number of restarts")
         ("maximum-number-of-iterations,", po::value<int>(), "set the maximum number of iterations")
         ("maximum-number-of-iterations-without-improvement,", po::value<int>(), "set the maximum number of iterations without improvement")
+        ("lagrangian-relaxation-bound,", "compute a Lagrangian relaxation bound alongside the large neighborhood search")
+        ("deterministic,", "weight the destroy operators of the large neighborhood search by gain per iteration instead of per millisecond")
+        ("number-of-perturbations,", po::value<int>(), "set the number of perturbations generated at each node of the local search")
+        ("number-of-islands,", po::value<int>(), "set the number of islands of the local search")
+        ("migration-interval,", po::value<double>(), "set the time between two migrations in seconds")
+        ("migration-topology,", po::value<std::string>(), "set the migration topology (ring, complete)")
+        ("restart-interval,", po::value<int>(), "set the number of iterations between two restarts of the lagging walkers")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
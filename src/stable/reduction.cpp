@@ -3,11 +3,88 @@
 #include "stablesolver/stable/instance_builder.hpp"
 
 #include "optimizationtools/containers/indexed_set.hpp"
-#include "optimizationtools/containers/indexed_map.hpp"
 #include "optimizationtools/containers/doubly_indexed_map.hpp"
 
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <cstdio>
+#include <algorithm>
+
 using namespace stablesolver::stable;
 
+namespace
+{
+
+/** Identifier written at the beginning of the reduction cache files. */
+const uint64_t cache_file_magic = 0x3230304445525353;  // "SSRED002"
+
+void hash_combine(
+        uint64_t& hash,
+        uint64_t value)
+{
+    // FNV-1a on the bytes of the value.
+    for (int byte = 0; byte < 8; ++byte) {
+        hash ^= (value >> (8 * byte)) & 0xff;
+        hash *= 0x100000001b3;
+    }
+}
+
+template <typename T>
+void write_value(
+        std::ofstream& file,
+        T value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void write_vector(
+        std::ofstream& file,
+        const std::vector<T>& values)
+{
+    write_value<uint64_t>(file, values.size());
+    file.write(
+            reinterpret_cast<const char*>(values.data()),
+            sizeof(T) * values.size());
+}
+
+template <typename T>
+bool read_value(
+        std::ifstream& file,
+        T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return file.good();
+}
+
+template <typename T>
+bool read_vector(
+        std::ifstream& file,
+        std::vector<T>& values)
+{
+    uint64_t size = 0;
+    if (!read_value(file, size))
+        return false;
+    // Check the size against the remaining length of the file, so that a
+    // corrupted size doesn't lead to a huge allocation.
+    std::streampos position = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos end = file.tellg();
+    file.seekg(position);
+    if (!file.good() || size > (uint64_t)(end - position) / sizeof(T))
+        return false;
+    values.resize(size);
+    file.read(
+            reinterpret_cast<char*>(values.data()),
+            sizeof(T) * values.size());
+    return file.good();
+}
+
+}
+
 bool Reduction::reduce_pendant_vertices()
 {
     optimizationtools::DoublyIndexedMap fixed_vertices(instance().number_of_vertices(), 2);
@@ -28,29 +105,17 @@ bool Reduction::reduce_pendant_vertices()
     if (fixed_vertices.number_of_elements() == 0)
         return false;
 
-    std::vector<UnreductionOperations> new_unreduction_operations;
-    std::vector<VertexId> new_mandatory_vertices;
-
-    // Update mandatory_vertices.
-    new_mandatory_vertices = mandatory_vertices_;
-    for (auto it = fixed_vertices.begin(1); it != fixed_vertices.end(1); ++it) {
-        VertexId vertex_id = *it;
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].in) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    for (auto it = fixed_vertices.begin(0); it != fixed_vertices.end(0); ++it) {
-        VertexId vertex_id = *it;
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].out) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    // Create new instance and compute unreduction_operations.
+    // Update fixed nodes.
+    for (auto it = fixed_vertices.begin(1); it != fixed_vertices.end(1); ++it)
+        fixed_literals_.push_back(vertex_nodes_[*it]);
+    for (auto it = fixed_vertices.begin(0); it != fixed_vertices.end(0); ++it)
+        fixed_literals_.push_back(~vertex_nodes_[*it]);
+    // Create new instance and compute vertex nodes.
     VertexId new_number_of_vertices = instance().number_of_vertices()
         - fixed_vertices.number_of_elements();
     InstanceBuilder new_instance_builder;
     new_instance_builder.add_vertices(new_number_of_vertices);
-    new_unreduction_operations = std::vector<UnreductionOperations>(new_number_of_vertices);
+    std::vector<VertexId> new_vertex_nodes(new_number_of_vertices);
     // Add vertices.
     std::vector<VertexId> original2reduced(instance().number_of_vertices(), -1);
     VertexId new_vertex_id = 0;
@@ -58,8 +123,7 @@ bool Reduction::reduce_pendant_vertices()
         VertexId vertex_id = *it;
         original2reduced[vertex_id] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
-        new_unreduction_operations[new_vertex_id]
-            = unreduction_operations_[vertex_id];
+        new_vertex_nodes[new_vertex_id] = vertex_nodes_[vertex_id];
         new_vertex_id++;
     }
     // Add edges.
@@ -76,8 +140,7 @@ bool Reduction::reduce_pendant_vertices()
         }
     }
 
-    unreduction_operations_ = new_unreduction_operations;
-    mandatory_vertices_ = new_mandatory_vertices;
+    vertex_nodes_.swap(new_vertex_nodes);
     instance_ = new_instance_builder.build();
     return true;
 }
@@ -85,35 +148,40 @@ bool Reduction::reduce_pendant_vertices()
 bool Reduction::reduce_isolated_vertex_removal()
 {
     //std::cout << "Isolated vertex removal..." << std::endl;
-    optimizationtools::IndexedSet neighbors(instance().number_of_vertices());
     optimizationtools::DoublyIndexedMap fixed_vertices(instance().number_of_vertices(), 2);
     for (VertexId vertex_id = 0;
             vertex_id < instance().number_of_vertices();
             ++vertex_id) {
+        if (vertex_id % 256 == 0 && needs_to_end())
+            break;
         if (fixed_vertices.contains(vertex_id))
             continue;
+        const Vertex& vertex = instance().vertex(vertex_id);
+        // Check if the vertex is at least as heavy as its neighbors.
         bool neighbors_clique = true;
-        for (const auto& edge: instance().vertex(vertex_id).edges) {
-            if (fixed_vertices.contains(edge.vertex_id))
+        for (const auto& edge: vertex.edges) {
+            if (!fixed_vertices.contains(edge.vertex_id)
+                    && vertex.weight < instance().vertex(edge.vertex_id).weight) {
+                neighbors_clique = false;
+                break;
+            }
+        }
+        // Check if its neighbors form a clique.
+        for (auto it_1 = vertex.edges.begin();
+                neighbors_clique && it_1 != vertex.edges.end();
+                ++it_1) {
+            if (fixed_vertices.contains(it_1->vertex_id))
                 continue;
-            // Check if all neighbors of v are neighbors of edge.v.
-            neighbors.clear();
-            neighbors.add(edge.vertex_id);
-            for (const auto& edge_2: instance().vertex(edge.vertex_id).edges)
-                if (!fixed_vertices.contains(edge_2.vertex_id))
-                    neighbors.add(edge_2.vertex_id);
-            for (const auto& edge: instance().vertex(vertex_id).edges) {
-                if (!fixed_vertices.contains(edge.vertex_id)) {
-                    if (!neighbors.contains(edge.vertex_id)
-                            || instance().vertex(vertex_id).weight
-                            < instance().vertex(edge.vertex_id).weight) {
-                        neighbors_clique = false;
-                        break;
-                    }
+            for (auto it_2 = vertex.edges.begin(); it_2 != it_1; ++it_2) {
+                if (fixed_vertices.contains(it_2->vertex_id)
+                        || it_2->vertex_id == it_1->vertex_id) {
+                    continue;
+                }
+                if (!instance().has_edge(it_1->vertex_id, it_2->vertex_id)) {
+                    neighbors_clique = false;
+                    break;
                 }
             }
-            if (!neighbors_clique)
-                break;
         }
         if (neighbors_clique) {
             fixed_vertices.set(vertex_id, 1);
@@ -127,29 +195,17 @@ bool Reduction::reduce_isolated_vertex_removal()
     if (fixed_vertices.number_of_elements() == 0)
         return false;
 
-    std::vector<UnreductionOperations> new_unreduction_operations;
-    std::vector<VertexId> new_mandatory_vertices;
-
-    // Update mandatory_vertices.
-    new_mandatory_vertices = mandatory_vertices_;
-    for (auto it = fixed_vertices.begin(1); it != fixed_vertices.end(1); ++it) {
-        VertexId vertex_id = *it;
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].in) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    for (auto it = fixed_vertices.begin(0); it != fixed_vertices.end(0); ++it) {
-        VertexId vertex_id = *it;
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].out) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    // Create new instance and compute unreduction_operations.
+    // Update fixed nodes.
+    for (auto it = fixed_vertices.begin(1); it != fixed_vertices.end(1); ++it)
+        fixed_literals_.push_back(vertex_nodes_[*it]);
+    for (auto it = fixed_vertices.begin(0); it != fixed_vertices.end(0); ++it)
+        fixed_literals_.push_back(~vertex_nodes_[*it]);
+    // Create new instance and compute vertex nodes.
     VertexId new_number_of_vertices = instance().number_of_vertices()
         - fixed_vertices.number_of_elements();
     InstanceBuilder new_instance_builder;
     new_instance_builder.add_vertices(new_number_of_vertices);
-    new_unreduction_operations = std::vector<UnreductionOperations>(new_number_of_vertices);
+    std::vector<VertexId> new_vertex_nodes(new_number_of_vertices);
     // Add vertices.
     std::vector<VertexId> original2reduced(instance().number_of_vertices(), -1);
     VertexId new_vertex_id = 0;
@@ -157,8 +213,7 @@ bool Reduction::reduce_isolated_vertex_removal()
         VertexId vertex_id = *it;
         original2reduced[vertex_id] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
-        new_unreduction_operations[new_vertex_id]
-            = unreduction_operations_[vertex_id];
+        new_vertex_nodes[new_vertex_id] = vertex_nodes_[vertex_id];
         new_vertex_id++;
     }
     // Add edges.
@@ -174,8 +229,7 @@ bool Reduction::reduce_isolated_vertex_removal()
         }
     }
 
-    unreduction_operations_ = new_unreduction_operations;
-    mandatory_vertices_ = new_mandatory_vertices;
+    vertex_nodes_.swap(new_vertex_nodes);
     instance_ = new_instance_builder.build();
     return true;
 }
@@ -200,14 +254,7 @@ bool Reduction::reduce_vertex_folding()
                 || instance().vertex(vertex_id).weight != instance().vertex(vertex_id_2).weight)
             continue;
         // Check if there exists an edge (vertex_id_1, vertex_id_2).
-        bool ok = true;
-        for (const auto& edge: instance().vertex(vertex_id_1).edges) {
-            if (edge.vertex_id == vertex_id_2) {
-                ok = false;
-                break;
-            }
-        }
-        if (!ok)
+        if (instance().has_edge(vertex_id_1, vertex_id_2))
             continue;
         //std::cout << "v " << v << " vertex_id_1 " << vertex_id_1 << " vertex_id_2 " << vertex_id_2 << std::endl;
         folded_vertices.add(vertex_id);
@@ -220,16 +267,11 @@ bool Reduction::reduce_vertex_folding()
     if (folded_vertices_list.empty())
         return false;
 
-    std::vector<UnreductionOperations> new_unreduction_operations;
-    std::vector<VertexId> new_mandatory_vertices;
-
-    // Update mandatory_vertices.
-    new_mandatory_vertices = mandatory_vertices_;
-    // Update instance and unreduction_operations.
+    // Update instance and vertex nodes.
     VertexId new_number_of_vertices = instance().number_of_vertices() - folded_vertices.size() + folded_vertices_list.size();
     InstanceBuilder new_instance_builder;
     new_instance_builder.add_vertices(new_number_of_vertices);
-    new_unreduction_operations = std::vector<UnreductionOperations>(new_number_of_vertices);
+    std::vector<VertexId> new_vertex_nodes(new_number_of_vertices);
     // Add vertices.
     std::vector<VertexId> original2reduced(instance().number_of_vertices(), -1);
     VertexId new_vertex_id = 0;
@@ -237,8 +279,7 @@ bool Reduction::reduce_vertex_folding()
         VertexId vertex_id = *it;
         original2reduced[vertex_id] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
-        new_unreduction_operations[new_vertex_id]
-            = unreduction_operations_[vertex_id];
+        new_vertex_nodes[new_vertex_id] = vertex_nodes_[vertex_id];
         new_vertex_id++;
     }
     for (const auto& tuple: folded_vertices_list) {
@@ -258,20 +299,10 @@ bool Reduction::reduce_vertex_folding()
         original2reduced[vertex_id_2] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
 
-        for (VertexId vertex_id_3: unreduction_operations_[vertex_id].out)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_3);
-        for (VertexId vertex_id_3: unreduction_operations_[vertex_id].in)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_3);
-
-        for (VertexId vertex_id_3: unreduction_operations_[vertex_id_1].in)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_3);
-        for (VertexId vertex_id_3: unreduction_operations_[vertex_id_1].out)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_3);
-
-        for (VertexId vertex_id_3: unreduction_operations_[vertex_id_2].in)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_3);
-        for (VertexId vertex_id_3: unreduction_operations_[vertex_id_2].out)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_3);
+        new_vertex_nodes[new_vertex_id] = add_unreduction_node({
+                ~vertex_nodes_[vertex_id],
+                vertex_nodes_[vertex_id_1],
+                vertex_nodes_[vertex_id_2]});
 
         new_vertex_id++;
     }
@@ -307,8 +338,7 @@ bool Reduction::reduce_vertex_folding()
             new_instance_builder.add_edge(new_vertex_id, vertex_id_3_new, 0);
     }
 
-    unreduction_operations_ = new_unreduction_operations;
-    mandatory_vertices_ = new_mandatory_vertices;
+    vertex_nodes_.swap(new_vertex_nodes);
     instance_ = new_instance_builder.build();
     return true;
 }
@@ -320,11 +350,12 @@ bool Reduction::reduce_twin()
     // 1: added
     // 2: folded
     optimizationtools::DoublyIndexedMap modified_vertices(instance().number_of_vertices(), 3);
-    optimizationtools::IndexedMap<VertexPos> twin_candidates(instance().number_of_vertices(), 0);
     std::vector<std::tuple<VertexId, VertexId, VertexId, VertexId, VertexId>> folded_vertices_list;
     for (VertexId vertex_id = 0;
             vertex_id < instance().number_of_vertices();
             ++vertex_id) {
+        if (vertex_id % 256 == 0 && needs_to_end())
+            break;
         if (instance().degree(vertex_id) != 3)
             continue;
         VertexId vertex_id_1 = instance().vertex(vertex_id).edges[0].vertex_id;
@@ -340,37 +371,29 @@ bool Reduction::reduce_twin()
                 || instance().vertex(vertex_id_2).weight != weight
                 || instance().vertex(vertex_id_3).weight != weight)
             continue;
-        twin_candidates.clear();
-        for (const auto& edge: instance().vertex(vertex_id).edges) {
-            for (const auto& edge_2: instance().vertex(edge.vertex_id).edges) {
-                if (instance().degree(edge_2.vertex_id) != 3)
-                    continue;
-                if (edge_2.vertex_id == vertex_id)
-                    continue;
-                if (instance().vertex(edge_2.vertex_id).weight != weight)
-                    continue;
-                if (modified_vertices.contains(edge_2.vertex_id))
-                    continue;
-                twin_candidates.set(edge_2.vertex_id, twin_candidates[edge_2.vertex_id] + 1);
-            }
-        }
+        // A twin is a neighbor of 'vertex_id_1' with the same neighbors as
+        // 'vertex_id'.
         VertexId vertex_id_twin = -1;
-        for (auto p: twin_candidates) {
-            if (p.second == 3) {
-                vertex_id_twin = p.first;
+        for (const auto& edge: instance().vertex(vertex_id_1).edges) {
+            if (instance().degree(edge.vertex_id) != 3)
+                continue;
+            if (edge.vertex_id == vertex_id)
+                continue;
+            if (instance().vertex(edge.vertex_id).weight != weight)
+                continue;
+            if (modified_vertices.contains(edge.vertex_id))
+                continue;
+            if (instance().number_of_common_neighbors(vertex_id, edge.vertex_id) == 3) {
+                vertex_id_twin = edge.vertex_id;
                 break;
             }
         }
         if (vertex_id_twin == -1)
             continue;
         // Is there an edge inside vertex_id_1, vertex_id_2, vertex_id_3?
-        bool has_edge = false;
-        for (const auto& edge: instance().vertex(vertex_id_1).edges)
-            if (edge.vertex_id == vertex_id_2 || edge.vertex_id == vertex_id_3)
-                has_edge = true;
-        for (const auto& edge: instance().vertex(vertex_id_2).edges)
-            if (edge.vertex_id == vertex_id_3)
-                has_edge = true;
+        bool has_edge = instance().has_edge(vertex_id_1, vertex_id_2)
+            || instance().has_edge(vertex_id_1, vertex_id_3)
+            || instance().has_edge(vertex_id_2, vertex_id_3);
 
         if (has_edge) {
             modified_vertices.set(vertex_id, 1);
@@ -397,24 +420,12 @@ bool Reduction::reduce_twin()
     if (modified_vertices.number_of_elements() == 0)
         return false;
 
-    std::vector<UnreductionOperations> new_unreduction_operations;
-    std::vector<VertexId> new_mandatory_vertices;
-
-    // Update mandatory_vertices.
-    new_mandatory_vertices = mandatory_vertices_;
-    for (auto it = modified_vertices.begin(1); it != modified_vertices.end(1); ++it) {
-        VertexId vertex_id = *it;
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].in) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    for (auto it = modified_vertices.begin(0); it != modified_vertices.end(0); ++it) {
-        VertexId vertex_id = *it;
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].out) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    // Create new instance and compute unreduction_operations.
+    // Update fixed nodes.
+    for (auto it = modified_vertices.begin(1); it != modified_vertices.end(1); ++it)
+        fixed_literals_.push_back(vertex_nodes_[*it]);
+    for (auto it = modified_vertices.begin(0); it != modified_vertices.end(0); ++it)
+        fixed_literals_.push_back(~vertex_nodes_[*it]);
+    // Create new instance and compute vertex nodes.
     VertexId new_number_of_vertices = instance().number_of_vertices()
         - modified_vertices.number_of_elements(0)
         - modified_vertices.number_of_elements(1)
@@ -422,7 +433,7 @@ bool Reduction::reduce_twin()
         + modified_vertices.number_of_elements(2) / 5;
     InstanceBuilder new_instance_builder;
     new_instance_builder.add_vertices(new_number_of_vertices);
-    new_unreduction_operations = std::vector<UnreductionOperations>(new_number_of_vertices);
+    std::vector<VertexId> new_vertex_nodes(new_number_of_vertices);
     // Add vertices.
     std::vector<VertexId> original2reduced(instance().number_of_vertices(), -1);
     VertexId new_vertex_id = 0;
@@ -432,8 +443,7 @@ bool Reduction::reduce_twin()
         VertexId vertex_id = *it;
         original2reduced[vertex_id] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
-        new_unreduction_operations[new_vertex_id]
-            = unreduction_operations_[vertex_id];
+        new_vertex_nodes[new_vertex_id] = vertex_nodes_[vertex_id];
         new_vertex_id++;
     }
     for (const auto& tuple: folded_vertices_list) {
@@ -449,30 +459,12 @@ bool Reduction::reduce_twin()
         original2reduced[vertex_id_3] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
 
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id].out)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_tmp);
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id].in)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_tmp);
-
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_twin].out)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_tmp);
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_twin].in)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_tmp);
-
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_1].in)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_tmp);
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_1].out)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_tmp);
-
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_2].in)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_tmp);
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_2].out)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_tmp);
-
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_3].in)
-            new_unreduction_operations[new_vertex_id].in.push_back(vertex_id_tmp);
-        for (VertexId vertex_id_tmp: unreduction_operations_[vertex_id_3].out)
-            new_unreduction_operations[new_vertex_id].out.push_back(vertex_id_tmp);
+        new_vertex_nodes[new_vertex_id] = add_unreduction_node({
+                ~vertex_nodes_[vertex_id],
+                ~vertex_nodes_[vertex_id_twin],
+                vertex_nodes_[vertex_id_1],
+                vertex_nodes_[vertex_id_2],
+                vertex_nodes_[vertex_id_3]});
 
         new_vertex_id++;
     }
@@ -520,8 +512,7 @@ bool Reduction::reduce_twin()
             new_instance_builder.add_edge(new_vertex_id, vertex_id_tmp, 0);
     }
 
-    unreduction_operations_ = new_unreduction_operations;
-    mandatory_vertices_ = new_mandatory_vertices;
+    vertex_nodes_.swap(new_vertex_nodes);
     instance_ = new_instance_builder.build();
     return true;
 }
@@ -530,29 +521,19 @@ bool Reduction::reduce_domination()
 {
     //std::cout << "Vertex folding..." << std::endl;
     optimizationtools::IndexedSet removed_vertices(instance().number_of_vertices());
-    optimizationtools::IndexedSet neighbors(instance().number_of_vertices());
     for (VertexId vertex_id = 0;
             vertex_id < instance().number_of_vertices();
             ++vertex_id) {
+        if (vertex_id % 256 == 0 && needs_to_end())
+            break;
         Weight weight = instance().vertex(vertex_id).weight;
-        neighbors.clear();
-        for (const auto& edge: instance().vertex(vertex_id).edges)
-            neighbors.add(edge.vertex_id);
         bool can_be_removed = false;
         for (const auto& edge: instance().vertex(vertex_id).edges) {
             if (instance().vertex(edge.vertex_id).weight < weight)
                 continue;
             if (removed_vertices.contains(edge.vertex_id))
                 continue;
-            bool dominates = true;
-            for (const auto& edge_2: instance().vertex(edge.vertex_id).edges) {
-                if (edge_2.vertex_id != vertex_id
-                        && !neighbors.contains(edge_2.vertex_id)) {
-                    dominates = false;
-                    break;
-                }
-            }
-            if (dominates) {
+            if (instance().is_neighborhood_included(edge.vertex_id, vertex_id)) {
                 can_be_removed = true;
                 break;
             }
@@ -565,21 +546,14 @@ bool Reduction::reduce_domination()
     if (removed_vertices.size() == 0)
         return false;
 
-    std::vector<UnreductionOperations> new_unreduction_operations;
-    std::vector<VertexId> new_mandatory_vertices;
-
-    // Update mandatory_vertices.
-    new_mandatory_vertices = mandatory_vertices_;
-    for (VertexId vertex_id: removed_vertices) {
-        for (VertexId orig_vertex_id: unreduction_operations_[vertex_id].out) {
-            new_mandatory_vertices.push_back(orig_vertex_id);
-        }
-    }
-    // Update instance and unreduction_operations.
+    // Update fixed nodes.
+    for (VertexId vertex_id: removed_vertices)
+        fixed_literals_.push_back(~vertex_nodes_[vertex_id]);
+    // Update instance and vertex nodes.
     VertexId new_number_of_vertices = instance().number_of_vertices() - removed_vertices.size();
     InstanceBuilder new_instance_builder;
     new_instance_builder.add_vertices(new_number_of_vertices);
-    new_unreduction_operations = std::vector<UnreductionOperations>(new_number_of_vertices);
+    std::vector<VertexId> new_vertex_nodes(new_number_of_vertices);
     // Add vertices.
     std::vector<VertexId> original2reduced(instance().number_of_vertices(), -1);
     VertexId new_vertex_id = 0;
@@ -587,8 +561,7 @@ bool Reduction::reduce_domination()
         VertexId vertex_id = *it;
         original2reduced[vertex_id] = new_vertex_id;
         new_instance_builder.set_weight(new_vertex_id, instance().vertex(vertex_id).weight);
-        new_unreduction_operations[new_vertex_id]
-            = unreduction_operations_[vertex_id];
+        new_vertex_nodes[new_vertex_id] = vertex_nodes_[vertex_id];
         new_vertex_id++;
     }
     // Add edges.
@@ -604,8 +577,7 @@ bool Reduction::reduce_domination()
         new_instance_builder.add_edge(new_vertex_id_1, new_vertex_id_2, 0);
     }
 
-    unreduction_operations_ = new_unreduction_operations;
-    mandatory_vertices_ = new_mandatory_vertices;
+    vertex_nodes_.swap(new_vertex_nodes);
     instance_ = new_instance_builder.build();
     return true;
 }
@@ -619,6 +591,8 @@ bool Reduction::reduce_unconfined()
     for (VertexId vertex_id = 0;
             vertex_id < instance().number_of_vertices();
             ++vertex_id) {
+        if (vertex_id % 256 == 0 && needs_to_end())
+            break;
         // Minimum weight in S.
         // The unconfined reduction rule remains true while the minimum weight
         // in S is greater or equal to the maximum weight in N(S).
@@ -710,21 +684,14 @@ bool Reduction::reduce_unconfined()
     if (removed_vertices.size() == 0)
         return false;
 
-    std::vector<UnreductionOperations> new_unreduction_operations;
-    std::vector<VertexId> new_mandatory_vertices;
-
-    // Update mandatory_vertices.
-    new_mandatory_vertices = mandatory_vertices_;
-    for (VertexId vertex_id: removed_vertices) {
-        for (VertexId vertex_id_2: unreduction_operations_[vertex_id].out) {
-            new_mandatory_vertices.push_back(vertex_id_2);
-        }
-    }
-    // Update instance and unreduction_operations.
+    // Update fixed nodes.
+    for (VertexId vertex_id: removed_vertices)
+        fixed_literals_.push_back(~vertex_nodes_[vertex_id]);
+    // Update instance and vertex nodes.
     VertexId new_number_of_vertices = instance().number_of_vertices() - removed_vertices.size();
     InstanceBuilder new_instance_builder;
     new_instance_builder.add_vertices(new_number_of_vertices);
-    new_unreduction_operations = std::vector<UnreductionOperations>(new_number_of_vertices);
+    std::vector<VertexId> new_vertex_nodes(new_number_of_vertices);
     // Add vertices.
     std::vector<VertexId> original2reduced(instance().number_of_vertices(), -1);
     VertexId new_vertex_id = 0;
@@ -734,8 +701,7 @@ bool Reduction::reduce_unconfined()
         new_instance_builder.set_weight(
                 new_vertex_id,
                 instance().vertex(vertex_id).weight);
-        new_unreduction_operations[new_vertex_id]
-            = unreduction_operations_[vertex_id];
+        new_vertex_nodes[new_vertex_id] = vertex_nodes_[vertex_id];
         new_vertex_id++;
     }
     // Add edges.
@@ -750,8 +716,7 @@ bool Reduction::reduce_unconfined()
         new_instance_builder.add_edge(new_vertex_id_1, new_vertex_id_2, 0);
     }
 
-    unreduction_operations_ = new_unreduction_operations;
-    mandatory_vertices_ = new_mandatory_vertices;
+    vertex_nodes_.swap(new_vertex_nodes);
     instance_ = new_instance_builder.build();
     return true;
 }
@@ -759,55 +724,387 @@ bool Reduction::reduce_unconfined()
 Reduction::Reduction(
         const Instance& instance,
         const ReductionParameters& parameters):
-    original_instance_(&instance),
-    instance_(instance)
+    original_instance_(&instance)
+{
+    if (parameters.cache_directory.empty()) {
+        reduce(parameters);
+        return;
+    }
+
+    uint64_t key = cache_key(instance, parameters);
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << key;
+    std::string cache_path = parameters.cache_directory
+        + "/" + ss.str() + ".reduction";
+    if (read(cache_path, key))
+        return;
+    reduce(parameters);
+    // Don't store a reduction stopped by the time limit, it is not
+    // reproducible. The cache is optional, so a reduction which can't be
+    // stored is still used.
+    if (!interrupted_ && !write(cache_path, key)) {
+        std::cerr << "Warning: unable to write reduction cache file \""
+            << cache_path << "\"." << std::endl;
+    }
+}
+
+void Reduction::reduce(
+        const ReductionParameters& parameters)
 {
+    const Instance& instance = *original_instance_;
+
     // Initialize reduced instance.
-    unreduction_operations_ = std::vector<UnreductionOperations>(instance.number_of_vertices());
+    instance_ = instance;
+    unreduction_children_starts_ = {0};
+    unreduction_children_.clear();
+    fixed_literals_.clear();
+    vertex_nodes_ = std::vector<VertexId>(instance.number_of_vertices());
     for (VertexId vertex_id = 0;
             vertex_id < instance.number_of_vertices();
             ++vertex_id) {
-        unreduction_operations_[vertex_id].in.push_back(vertex_id);
+        vertex_nodes_[vertex_id] = vertex_id;
+    }
+
+    if (parameters.time_limit == std::numeric_limits<double>::infinity()) {
+        end_time_ = std::chrono::steady_clock::time_point::max();
+    } else {
+        end_time_ = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(parameters.time_limit));
     }
 
+    // Reduction rules, in their default order.
+    struct ReductionRule
+    {
+        /** Method applying the rule. */
+        bool (Reduction::*reduce)();
+
+        /** Number of calls. */
+        Counter number_of_calls = 0;
+
+        /** Number of consecutive calls which didn't reduce the instance. */
+        Counter number_of_consecutive_failures = 0;
+
+        /** Number of vertices removed by the rule. */
+        VertexId number_of_removed_vertices = 0;
+
+        /** Time spent in the rule. */
+        double time = 0.0;
+
+        /** Number of vertices removed per second. */
+        double yield() const
+        {
+            if (number_of_calls == 0)
+                return std::numeric_limits<double>::infinity();
+            if (time == 0.0)
+                return (number_of_removed_vertices > 0)?
+                    std::numeric_limits<double>::infinity(): 0.0;
+            return number_of_removed_vertices / time;
+        }
+    };
+    std::vector<ReductionRule> rules = {
+        {&Reduction::reduce_pendant_vertices},
+        {&Reduction::reduce_vertex_folding},
+        {&Reduction::reduce_isolated_vertex_removal},
+        {&Reduction::reduce_twin},
+        {&Reduction::reduce_domination},
+        {&Reduction::reduce_unconfined}};
+
     for (Counter round_number = 0;
             round_number < parameters.maximum_number_of_rounds;
             ++round_number) {
+
+        // With a time limit, apply the rules which removed the most vertices
+        // per second first. Without a time limit, the order is fixed, since
+        // the kernel depends on it and must be reproducible.
+        if (parameters.time_limit != std::numeric_limits<double>::infinity()) {
+            std::stable_sort(
+                    rules.begin(),
+                    rules.end(),
+                    [](const ReductionRule& rule_1, const ReductionRule& rule_2)
+                    {
+                        return rule_1.yield() > rule_2.yield();
+                    });
+        }
+
         bool found = false;
-        found |= reduce_pendant_vertices();
-        found |= reduce_vertex_folding();
-        found |= reduce_isolated_vertex_removal();
-        found |= reduce_twin();
-        found |= reduce_domination();
-        found |= reduce_unconfined();
-        if (!found)
+        for (ReductionRule& rule: rules) {
+            if (needs_to_end())
+                break;
+            // With a time limit, a rule which didn't reduce the instance in
+            // two consecutive calls is not called anymore. Without a time
+            // limit, all rules are called in each round, since a rule may
+            // apply again after the other rules have reduced the instance.
+            if (parameters.time_limit != std::numeric_limits<double>::infinity()
+                    && rule.number_of_consecutive_failures >= 2) {
+                continue;
+            }
+
+            VertexId number_of_vertices = instance_.number_of_vertices();
+            auto start = std::chrono::steady_clock::now();
+            bool rule_found = (this->*rule.reduce)();
+            auto end = std::chrono::steady_clock::now();
+
+            rule.number_of_calls++;
+            rule.time += std::chrono::duration<double>(end - start).count();
+            rule.number_of_removed_vertices += number_of_vertices
+                - instance_.number_of_vertices();
+            if (rule_found) {
+                rule.number_of_consecutive_failures = 0;
+                found = true;
+            } else {
+                rule.number_of_consecutive_failures++;
+            }
+        }
+        if (!found || interrupted_)
             break;
     }
 
-    extra_weight_ = 0;
-    for (VertexId orig_vertex_id: mandatory_vertices_)
-        extra_weight_ += instance.vertex(orig_vertex_id).weight;
+    // The weight of a solution of the original instance is the weight of the
+    // corresponding solution of the reduced instance plus a constant: the
+    // weight of the unreduced empty solution.
+    extra_weight_ = unreduce_solution(Solution(instance_)).weight();
+}
+
+bool Reduction::needs_to_end()
+{
+    if (!interrupted_ && std::chrono::steady_clock::now() >= end_time_)
+        interrupted_ = true;
+    return interrupted_;
+}
+
+VertexId Reduction::add_unreduction_node(
+        std::initializer_list<VertexId> literals)
+{
+    VertexId node_id = original_instance_->number_of_vertices()
+        + unreduction_children_starts_.size() - 1;
+    unreduction_children_.insert(
+            unreduction_children_.end(),
+            literals.begin(),
+            literals.end());
+    unreduction_children_starts_.push_back(unreduction_children_.size());
+    return node_id;
+}
+
+uint64_t Reduction::cache_key(
+        const Instance& instance,
+        const ReductionParameters& parameters)
+{
+    uint64_t hash = 0xcbf29ce484222325;
+    hash_combine(hash, cache_file_magic);
+    hash_combine(hash, parameters.maximum_number_of_rounds);
+    hash_combine(hash, instance.number_of_vertices());
+    for (VertexId vertex_id = 0;
+            vertex_id < instance.number_of_vertices();
+            ++vertex_id) {
+        hash_combine(hash, instance.vertex(vertex_id).weight);
+    }
+    hash_combine(hash, instance.number_of_edges());
+    for (EdgeId edge_id = 0;
+            edge_id < instance.number_of_edges();
+            ++edge_id) {
+        hash_combine(hash, instance.edge(edge_id).vertex_id_1);
+        hash_combine(hash, instance.edge(edge_id).vertex_id_2);
+    }
+    return hash;
+}
+
+bool Reduction::read(
+        const std::string& cache_path,
+        uint64_t key)
+{
+    std::ifstream file(cache_path, std::ios::binary);
+    if (!file.good())
+        return false;
+
+    // Check that the file corresponds to the original instance.
+    uint64_t magic = 0;
+    uint64_t file_key = 0;
+    VertexId original_number_of_vertices = -1;
+    EdgeId original_number_of_edges = -1;
+    if (!read_value(file, magic)
+            || magic != cache_file_magic
+            || !read_value(file, file_key)
+            || file_key != key
+            || !read_value(file, original_number_of_vertices)
+            || original_number_of_vertices != original_instance_->number_of_vertices()
+            || !read_value(file, original_number_of_edges)
+            || original_number_of_edges != original_instance_->number_of_edges()) {
+        return false;
+    }
+
+    // Read reduced instance.
+    std::vector<Weight> weights;
+    std::vector<VertexId> edges;
+    if (!read_vector(file, weights) || !read_vector(file, edges))
+        return false;
+    VertexId number_of_vertices = weights.size();
+    if (edges.size() % 2 != 0)
+        return false;
+    for (VertexId vertex_id: edges)
+        if (vertex_id < 0 || vertex_id >= number_of_vertices)
+            return false;
+
+    // Read unreduction log. It is only stored in the reduction once it has
+    // been fully checked, so that a corrupted file leaves it empty.
+    std::vector<VertexId> vertex_nodes;
+    std::vector<VertexId> unreduction_children_starts;
+    std::vector<VertexId> unreduction_children;
+    std::vector<VertexId> fixed_literals;
+    Weight extra_weight = 0;
+    if (!read_vector(file, vertex_nodes)
+            || !read_vector(file, unreduction_children_starts)
+            || !read_vector(file, unreduction_children)
+            || !read_vector(file, fixed_literals)
+            || !read_value(file, extra_weight)) {
+        return false;
+    }
+    if ((VertexId)vertex_nodes.size() != number_of_vertices
+            || unreduction_children_starts.empty()
+            || unreduction_children_starts.front() != 0
+            || unreduction_children_starts.back()
+            != (VertexId)unreduction_children.size()) {
+        return false;
+    }
+    VertexId node_offset = original_number_of_vertices;
+    VertexId number_of_nodes = node_offset
+        + unreduction_children_starts.size() - 1;
+    for (VertexId node_id: vertex_nodes)
+        if (node_id < 0 || node_id >= number_of_nodes)
+            return false;
+    for (VertexId literal: fixed_literals)
+        if (literal >= number_of_nodes || ~literal >= number_of_nodes)
+            return false;
+    // The children of a node are created before it.
+    for (VertexId node_id = node_offset; node_id < number_of_nodes; ++node_id) {
+        VertexId start = unreduction_children_starts[node_id - node_offset];
+        VertexId end = unreduction_children_starts[node_id - node_offset + 1];
+        if (start > end)
+            return false;
+        for (VertexId pos = start; pos < end; ++pos) {
+            VertexId literal = unreduction_children[pos];
+            if (literal >= node_id || ~literal >= node_id)
+                return false;
+        }
+    }
+
+    InstanceBuilder instance_builder;
+    instance_builder.add_vertices(number_of_vertices);
+    for (VertexId vertex_id = 0;
+            vertex_id < number_of_vertices;
+            ++vertex_id) {
+        instance_builder.set_weight(vertex_id, weights[vertex_id]);
+    }
+    for (EdgePos edge_pos = 0;
+            edge_pos + 1 < (EdgePos)edges.size();
+            edge_pos += 2) {
+        instance_builder.add_edge(edges[edge_pos], edges[edge_pos + 1], 0);
+    }
+    instance_ = instance_builder.build();
+    vertex_nodes_.swap(vertex_nodes);
+    unreduction_children_starts_.swap(unreduction_children_starts);
+    unreduction_children_.swap(unreduction_children);
+    fixed_literals_.swap(fixed_literals);
+    extra_weight_ = extra_weight;
+    return true;
+}
+
+bool Reduction::write(
+        const std::string& cache_path,
+        uint64_t key) const
+{
+    // Write to a temporary file first, so that concurrent runs never read a
+    // partially written file.
+    std::string tmp_path = cache_path
+        + "." + std::to_string(std::random_device()()) + ".tmp";
+    std::ofstream file(tmp_path, std::ios::binary);
+    if (!file.good())
+        return false;
+
+    write_value(file, cache_file_magic);
+    write_value(file, key);
+    write_value(file, original_instance_->number_of_vertices());
+    write_value(file, original_instance_->number_of_edges());
+
+    // Write reduced instance.
+    std::vector<Weight> weights(instance().number_of_vertices());
+    for (VertexId vertex_id = 0;
+            vertex_id < instance().number_of_vertices();
+            ++vertex_id) {
+        weights[vertex_id] = instance().vertex(vertex_id).weight;
+    }
+    std::vector<VertexId> edges;
+    edges.reserve(2 * instance().number_of_edges());
+    for (EdgeId edge_id = 0;
+            edge_id < instance().number_of_edges();
+            ++edge_id) {
+        edges.push_back(instance().edge(edge_id).vertex_id_1);
+        edges.push_back(instance().edge(edge_id).vertex_id_2);
+    }
+    write_vector(file, weights);
+    write_vector(file, edges);
+
+    // Write unreduction log.
+    write_vector(file, vertex_nodes_);
+    write_vector(file, unreduction_children_starts_);
+    write_vector(file, unreduction_children_);
+    write_vector(file, fixed_literals_);
+    write_value(file, extra_weight_);
+
+    file.close();
+    if (!file.good()
+            || std::rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
 }
 
 Solution Reduction::unreduce_solution(
         const Solution& solution) const
 {
-    Solution new_solution(*original_instance_);
-
-    for (VertexId vertex_id: mandatory_vertices_)
-        new_solution.add(vertex_id);
+    VertexId number_of_nodes = original_instance_->number_of_vertices()
+        + unreduction_children_starts_.size() - 1;
 
+    // Compute the state of the nodes of the reduced instance and of the fixed
+    // nodes.
+    std::vector<uint8_t> nodes_in(number_of_nodes, 0);
     for (VertexId vertex_id = 0;
             vertex_id < instance().number_of_vertices();
             ++vertex_id) {
         if (solution.contains(vertex_id))
-            for (VertexId vertex_id_2: unreduction_operations_[vertex_id].in)
-                new_solution.add(vertex_id_2);
-        if (!solution.contains(vertex_id))
-            for (VertexId vertex_id_2: unreduction_operations_[vertex_id].out)
-                new_solution.add(vertex_id_2);
+            nodes_in[vertex_nodes_[vertex_id]] = 1;
     }
+    for (VertexId literal: fixed_literals_)
+        if (literal >= 0)
+            nodes_in[literal] = 1;
 
+    // Propagate the states to the children. Children are always created
+    // before their parent, so a single sweep in reverse order is enough.
+    VertexId node_offset = original_instance_->number_of_vertices();
+    for (VertexId node_id = number_of_nodes - 1;
+            node_id >= node_offset;
+            --node_id) {
+        uint8_t in = nodes_in[node_id];
+        for (VertexId pos = unreduction_children_starts_[node_id - node_offset];
+                pos < unreduction_children_starts_[node_id - node_offset + 1];
+                ++pos) {
+            VertexId literal = unreduction_children_[pos];
+            if (literal >= 0) {
+                nodes_in[literal] = in;
+            } else {
+                nodes_in[~literal] = !in;
+            }
+        }
+    }
+
+    Solution new_solution(*original_instance_);
+    for (VertexId vertex_id = 0;
+            vertex_id < original_instance_->number_of_vertices();
+            ++vertex_id) {
+        if (nodes_in[vertex_id])
+            new_solution.add(vertex_id);
+    }
     return new_solution;
 }
 